@@ -0,0 +1,919 @@
+#include "BWidgets/BWidgets.hpp"
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+/**
+ * Counter of heap allocations via operator new.
+ */
+static std::atomic<long> allocations (0);
+
+void* operator new (size_t size)
+{
+	++allocations;
+	void* ptr = malloc (size ? size : 1);
+	if (!ptr) throw std::bad_alloc ();
+	return ptr;
+}
+
+void operator delete (void* ptr) noexcept {free (ptr);}
+void operator delete (void* ptr, size_t) noexcept {free (ptr);}
+
+/**
+ * Makes the protected draw method of a widget class accessible.
+ */
+template<class T> class Drawable : public T
+{
+public:
+	using T::T;
+	void redraw () {this->draw (0, 0, this->getWidth (), this->getHeight ());}
+};
+
+/**
+ * Gets a time stamp in microseconds.
+ */
+static double now ()
+{
+	return std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+/**
+ * Runs a function repeatedly.
+ * @param runs Number of runs
+ * @param func Function to be measured
+ * @return Mean time per run in microseconds
+ */
+template<typename Func> static double measure (const int runs, Func func)
+{
+	double t0 = now ();
+	for (int i = 0; i < runs; ++i) func (i);
+	return (now () - t0) / runs;
+}
+
+static void report (const std::string& scenario, const std::string& variant, const double microseconds)
+{
+	std::cout << scenario << "\t" << variant << "\t" << microseconds << " us" << std::endl;
+}
+
+/**
+ * Reports the percentiles of the times per pass, the composites (rendered
+ * frames) per second and the heap allocations per pass.
+ * @param times Times per pass in microseconds
+ * @param composites Number of composites within all passes
+ * @param allocs Number of heap allocations within all passes
+ */
+static void reportPasses (const std::string& scenario, const std::string& variant, std::vector<double> times, const long composites, const long allocs)
+{
+	if (times.empty ()) return;
+
+	std::sort (times.begin (), times.end ());
+	double total = 0.0;
+	for (double t : times) total += t;
+	auto percentile = [&times] (const double p) {return times[std::min (times.size () - 1, size_t (p * times.size ()))];};
+
+	std::cout << scenario << "\t" << variant
+			  << "\tp50 " << percentile (0.5) << " us"
+			  << "\tp90 " << percentile (0.9) << " us"
+			  << "\tp99 " << percentile (0.99) << " us"
+			  << "\tmax " << times.back () << " us"
+			  << "\t" << (total > 0.0 ? composites * 1000000.0 / total : 0.0) << " composites/s"
+			  << "\t" << double (allocs) / times.size () << " allocs/pass" << std::endl;
+}
+
+/**
+ * Offscreen test scene: An offscreen window with a grid of N widgets of
+ * 40x40 pixels each (dials, sliders, buttons and labels named after the
+ * style sets of the themes used in the benchmarks).
+ */
+struct Scene
+{
+	BWidgets::Window* window;
+	std::vector<BWidgets::Widget*> widgets;
+	std::vector<BWidgets::ValueWidget*> values;
+	std::vector<BWidgets::Dial*> dials;
+	std::vector<BWidgets::HSlider*> sliders;
+
+	Scene (const int nrWidgets)
+	{
+		const int cell = 40;
+		const int columns = ceil (sqrt (nrWidgets));
+		const int rows = (nrWidgets + columns - 1) / columns;
+		window = new BWidgets::Window (columns * cell, rows * cell, "Window");
+
+		for (int i = 0; i < nrWidgets; ++i)
+		{
+			double x = (i % columns) * cell;
+			double y = (i / columns) * cell;
+			BWidgets::Widget* w;
+
+			switch (i % 4)
+			{
+			case 0:		{
+							BWidgets::Dial* d = new BWidgets::Dial (x, y, cell, cell, "Dial", 0.0, 0.0, 1.0, 0.0);
+							dials.push_back (d);
+							values.push_back (d);
+							w = d;
+						}
+						break;
+
+			case 1:		{
+							BWidgets::HSlider* h = new BWidgets::HSlider (x, y, cell, cell, "Slider", 0.0, 0.0, 1.0, 0.0);
+							sliders.push_back (h);
+							values.push_back (h);
+							w = h;
+						}
+						break;
+
+			case 2:		{
+							BWidgets::Button* b = new BWidgets::Button (x, y, cell, cell, "Button", 0.0);
+							values.push_back (b);
+							w = b;
+						}
+						break;
+
+			default:	w = new BWidgets::Label (x, y, cell, cell, "Label");
+						break;
+			}
+
+			widgets.push_back (w);
+			window->add (*w);
+		}
+	}
+
+	~Scene ()
+	{
+		for (BWidgets::Widget* w : widgets) delete w;
+		delete window;
+	}
+};
+
+static void postButton (BWidgets::Window* window, const PuglEventType type, const double x, const double y)
+{
+	PuglEvent event;
+	memset (&event, 0, sizeof (event));
+	event.button.type = type;
+	event.button.x = x;
+	event.button.y = y;
+	event.button.button = BEvents::LEFT_BUTTON;
+	window->postPuglEvent (&event);
+}
+
+static void postMotion (BWidgets::Window* window, const double x, const double y)
+{
+	PuglEvent event;
+	memset (&event, 0, sizeof (event));
+	event.motion.type = PUGL_MOTION_NOTIFY;
+	event.motion.x = x;
+	event.motion.y = y;
+	window->postPuglEvent (&event);
+}
+
+static void postConfigure (BWidgets::Window* window, const double width, const double height)
+{
+	PuglEvent event;
+	memset (&event, 0, sizeof (event));
+	event.configure.type = PUGL_CONFIGURE;
+	event.configure.width = width;
+	event.configure.height = height;
+	window->postPuglEvent (&event);
+}
+
+static const std::array<int, 4> treeSizes = {{10, 100, 1000, 10000}};
+
+/**
+ * Compares the former per-expose allocation of a full window storage surface
+ * (and a full window blit) with the persistent back buffer of
+ * BWidgets::Window (damaged area only) for a 1920x1080 window and a damaged
+ * area of a dial (80x80). The former expose path is emulated with plain
+ * cairo surfaces. The back buffer is measured on an offscreen
+ * BWidgets::Window with a full-size background widget and a dial changing
+ * its value in each pass.
+ */
+static void benchBackBuffer ()
+{
+	const int width = 1920;
+	const int height = 1080;
+	const int runs = 500;
+	cairo_rectangle_int_t damage = {400, 300, 80, 80};
+
+	cairo_surface_t* target = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+	cairo_surface_t* widget = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+	cairo_surface_clear (widget);
+
+	// Old: New storage surface per expose, copy full surface
+	double tOld = measure (runs, [&] (int)
+	{
+		cairo_surface_t* storage = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+		cairo_t* cr = cairo_create (storage);
+		cairo_set_source_surface (cr, widget, 0, 0);
+		cairo_rectangle (cr, damage.x, damage.y, damage.width, damage.height);
+		cairo_fill (cr);
+		cairo_destroy (cr);
+
+		cr = cairo_create (target);
+		cairo_set_source_surface (cr, storage, 0, 0);
+		cairo_paint (cr);
+		cairo_destroy (cr);
+		cairo_surface_destroy (storage);
+	});
+	report ("backbuffer", "per-expose storage surface", tOld);
+
+	// New: Persistent back buffer, clear and copy the damaged area only
+	cairo_surface_t* storage = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+	double tNew = measure (runs, [&] (int)
+	{
+		cairo_t* cr = cairo_create (storage);
+		cairo_rectangle (cr, damage.x, damage.y, damage.width, damage.height);
+		cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+		cairo_fill (cr);
+		cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+		cairo_set_source_surface (cr, widget, 0, 0);
+		cairo_rectangle (cr, damage.x, damage.y, damage.width, damage.height);
+		cairo_fill (cr);
+		cairo_destroy (cr);
+
+		cr = cairo_create (target);
+		cairo_rectangle (cr, damage.x, damage.y, damage.width, damage.height);
+		cairo_clip (cr);
+		cairo_set_source_surface (cr, storage, 0, 0);
+		cairo_paint (cr);
+		cairo_destroy (cr);
+	});
+	report ("backbuffer", "persistent back buffer", tNew);
+
+	cairo_surface_destroy (storage);
+	cairo_surface_destroy (widget);
+	cairo_surface_destroy (target);
+
+	// Offscreen window
+	BWidgets::Window window (width, height, "Window");
+	BWidgets::Widget background (0, 0, width, height, "Background");
+	background.setBackground (BStyles::greyFill);
+	BWidgets::Dial dial (damage.x, damage.y, damage.width, damage.height, "Dial", 0.0, 0.0, 1.0, 0.0);
+	window.add (background);
+	window.add (dial);
+	window.handleEvents ();
+	window.resetFrameStatistics ();
+
+	std::vector<double> times;
+	long allocs = allocations;
+	for (int i = 0; i < runs; ++i)
+	{
+		double t0 = now ();
+		dial.setValue (i & 1);
+		window.handleEvents ();
+		times.push_back (now () - t0);
+	}
+	reportPasses ("backbuffer", "offscreen window, dial value changes", times, window.getFrameStatistics ().frames, allocations - allocs);
+}
+
+/**
+ * Compares the former walk along the parent chain with the cached absolute
+ * origin and effective visibility for the innermost widget of a 10-level
+ * deep widget tree.
+ */
+static void benchOrigin ()
+{
+	const int depth = 10;
+	const int runs = 1000000;
+	BWidgets::Widget widgets[depth];
+
+	for (int i = 0; i < depth; ++i) widgets[i].setWidth (10.0);
+	for (int i = 0; i + 1 < depth; ++i) widgets[i].add (widgets[i + 1]);
+	BWidgets::Widget* leaf = &widgets[depth - 1];
+	double sum = 0.0;
+
+	// Old: Walk along the parent chain on each call
+	double tWalk = measure (runs, [&] (int)
+	{
+		double x = 0.0;
+		double y = 0.0;
+		for (BWidgets::Widget* w = leaf; w->getParent (); w = w->getParent ())
+		{
+			x += w->getX ();
+			y += w->getY ();
+		}
+		sum += x + y;
+	});
+	report ("origin", "parent chain walk", tWalk);
+
+	// New: Cached origin
+	double tCached = measure (runs, [&] (int) {sum += leaf->getOriginX () + leaf->getOriginY ();});
+	report ("origin", "cached origin", tCached);
+
+	// New: Cached effective visibility
+	double tVisible = measure (runs, [&] (int) {sum += (leaf->isVisible () ? 1.0 : 0.0);});
+	report ("origin", "cached visibility", tVisible);
+
+	// New: Move the outermost child (invalidates the subtree) and get origin
+	double tMove = measure (runs / 10, [&] (int i)
+	{
+		widgets[1].moveTo (i & 1, 0.0);
+		sum += leaf->getOriginX () + leaf->getOriginY ();
+	});
+	report ("origin", "move + cached origin", tMove);
+
+	if (sum < 0.0) std::cerr << sum << std::endl;
+}
+
+/**
+ * Compares the single-threaded compositing of a full window redisplay with
+ * the tile-based parallel compositing (Window::setCompositingThreads) of an
+ * offscreen window at 1080p and 4K. The window is covered by a grid of
+ * overlapping semi-transparent 96x96 widgets.
+ */
+static void benchTiles ()
+{
+	const int widgetSize = 96;
+	const int runs = 50;
+	const int nrThreads = (std::thread::hardware_concurrency () > 1 ? std::thread::hardware_concurrency () - 1 : 1);
+	std::array<std::array<int, 2>, 2> sizes = {{{1920, 1080}, {3840, 2160}}};
+	BStyles::Fill fill (BColors::Color (0.2, 0.6, 0.2, 0.7));
+
+	for (std::array<int, 2>& size : sizes)
+	{
+		const int width = size[0];
+		const int height = size[1];
+		const std::string variant = std::to_string (width) + "x" + std::to_string (height);
+
+		BWidgets::Window window (width, height, "Window");
+		std::vector<BWidgets::Widget*> widgets;
+		for (int y = 0; y < height; y += widgetSize / 2)
+		{
+			for (int x = 0; x < width; x += widgetSize / 2)
+			{
+				BWidgets::Widget* w = new BWidgets::Widget (x, y, widgetSize, widgetSize, "widget");
+				w->setBackground (fill);
+				widgets.push_back (w);
+				window.add (*w);
+			}
+		}
+		window.handleEvents ();
+
+		for (int threads : {0, nrThreads})
+		{
+			window.setCompositingThreads (threads);
+			window.resetFrameStatistics ();
+			std::vector<double> times;
+			long allocs = allocations;
+
+			for (int i = 0; i < runs; ++i)
+			{
+				double t0 = now ();
+				window.postRedisplay ();
+				window.handleEvents ();
+				times.push_back (now () - t0);
+			}
+
+			std::string mode = (threads ? " tiles on " + std::to_string (threads + 1) + " threads" : " single-threaded");
+			reportPasses ("tiles", variant + mode, times, window.getFrameStatistics ().frames, allocations - allocs);
+		}
+
+		for (BWidgets::Widget* w : widgets) delete w;
+	}
+}
+
+static void changeValue (BWidgets::Widget*, const int) {}
+static void changeValue (BWidgets::ValueWidget* widget, const int i) {widget->setValue (i & 1);}
+
+/**
+ * Measures the draw method of a widget class at the sizes 20, 50, 100 and
+ * 200 pixels: Full draws after update () (which also invalidates widget
+ * caches) and, for value widgets, draws after value changes.
+ * @param name Widget class name
+ * @param create Function returning a new widget of a given size
+ * @param values Also measure value changes
+ */
+template<class T, typename Factory> static void benchDrawClass (const std::string& name, Factory create, const bool values)
+{
+	for (int size : {20, 50, 100, 200})
+	{
+		Drawable<T>* widget = create (size);
+		const int runs = std::max (20, 100000 / size);
+		const std::string variant = name + " " + std::to_string (int (widget->getWidth ())) + "x" + std::to_string (int (widget->getHeight ()));
+
+		double tFull = measure (runs, [&] (int)
+		{
+			widget->update ();
+			widget->redraw ();
+		});
+		report ("draw", variant + " full", tFull);
+
+		if (values)
+		{
+			double tValue = measure (runs, [&] (int i)
+			{
+				changeValue (widget, i);
+				widget->redraw ();
+			});
+			report ("draw", variant + " value", tValue);
+		}
+
+		delete widget;
+	}
+}
+
+/**
+ * Microbenchmarks of the draw methods of the widget classes.
+ */
+static void benchDraw ()
+{
+	BStyles::Fill imageFill = BStyles::Fill ("example-romedalen.png");
+	BStyles::Border roundedBorder = {BStyles::whiteLine1pt, 3.0, 3.0, 10.0};
+
+	benchDrawClass<BWidgets::Widget> ("Widget image", [&] (int s)
+	{
+		Drawable<BWidgets::Widget>* w = new Drawable<BWidgets::Widget> (0, 0, s, s, "widget");
+		w->setBackground (imageFill);
+		return w;
+	}, false);
+	benchDrawClass<BWidgets::Widget> ("Widget rounded", [&] (int s)
+	{
+		Drawable<BWidgets::Widget>* w = new Drawable<BWidgets::Widget> (0, 0, s, s, "widget");
+		w->setBackground (BStyles::greyFill);
+		w->setBorder (roundedBorder);
+		return w;
+	}, false);
+	benchDrawClass<BWidgets::Dial> ("Dial", [] (int s) {return new Drawable<BWidgets::Dial> (0, 0, s, s, "dial", 0.0, 0.0, 1.0, 0.0);}, true);
+	benchDrawClass<BWidgets::HSlider> ("HSlider", [] (int s) {return new Drawable<BWidgets::HSlider> (0, 0, 4 * s, s, "hslider", 0.0, 0.0, 1.0, 0.0);}, true);
+	benchDrawClass<BWidgets::VSlider> ("VSlider", [] (int s) {return new Drawable<BWidgets::VSlider> (0, 0, s, 4 * s, "vslider", 0.0, 0.0, 1.0, 0.0);}, true);
+	benchDrawClass<BWidgets::Button> ("Button", [] (int s) {return new Drawable<BWidgets::Button> (0, 0, s, s, "button", 0.0);}, true);
+	benchDrawClass<BWidgets::HSwitch> ("HSwitch", [] (int s) {return new Drawable<BWidgets::HSwitch> (0, 0, 2 * s, s, "hswitch", 0.0);}, true);
+	benchDrawClass<BWidgets::Label> ("Label", [] (int s) {return new Drawable<BWidgets::Label> (0, 0, 2 * s, s, "Label");}, false);
+	benchDrawClass<BWidgets::Text> ("Text", [] (int s)
+	{
+		return new Drawable<BWidgets::Text> (0, 0, 2 * s, s, "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.");
+	}, false);
+}
+
+/**
+ * Startup: Creation of an offscreen window with N widgets and rendering of
+ * the first frame.
+ */
+static void benchStartup ()
+{
+	for (int n : treeSizes)
+	{
+		const int runs = (n >= 10000 ? 3 : 10);
+		std::vector<double> times;
+		long allocs = allocations;
+
+		for (int i = 0; i < runs; ++i)
+		{
+			double t0 = now ();
+			Scene scene (n);
+			scene.window->handleEvents ();
+			times.push_back (now () - t0);
+		}
+
+		reportPasses ("startup", std::to_string (n) + " widgets", times, runs, allocations - allocs);
+	}
+}
+
+/**
+ * Widget trees: Value changes of 1 % of the widgets (at least one) per frame
+ * in trees of 10 to 10000 widgets.
+ */
+static void benchTree ()
+{
+	const int runs = 200;
+
+	for (int n : treeSizes)
+	{
+		Scene scene (n);
+		scene.window->handleEvents ();
+		scene.window->resetFrameStatistics ();
+
+		const size_t nrChanges = std::max (size_t (1), scene.values.size () / 100);
+		std::vector<double> times;
+		size_t next = 0;
+		long allocs = allocations;
+
+		for (int i = 0; i < runs; ++i)
+		{
+			double t0 = now ();
+			for (size_t j = 0; j < nrChanges; ++j)
+			{
+				BWidgets::ValueWidget* w = scene.values[next];
+				w->setValue (w->getValue () == 0.0 ? 1.0 : 0.0);
+				next = (next + 1) % scene.values.size ();
+			}
+			scene.window->handleEvents ();
+			times.push_back (now () - t0);
+		}
+
+		reportPasses ("tree", std::to_string (n) + " widgets", times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+	}
+}
+
+/**
+ * Slider drag storm: 10000 pointer motion events while dragging a slider
+ * knob, handled in passes of 10 events (a high polling rate mouse).
+ */
+static void benchDrag ()
+{
+	const int nrEvents = 10000;
+	const int eventsPerPass = 10;
+
+	Scene scene (100);
+	scene.window->handleEvents ();
+	BWidgets::HSlider* slider = scene.sliders.front ();
+	double x0 = slider->getOriginX ();
+	double y0 = slider->getOriginY () + 0.5 * slider->getHeight ();
+	postButton (scene.window, PUGL_BUTTON_PRESS, x0 + 0.5 * slider->getWidth (), y0);
+	scene.window->handleEvents ();
+	scene.window->resetFrameStatistics ();
+
+	std::vector<double> times;
+	long allocs = allocations;
+
+	for (int i = 0; i < nrEvents; i += eventsPerPass)
+	{
+		double t0 = now ();
+		for (int j = 0; j < eventsPerPass; ++j)
+		{
+			double pos = 0.5 + 0.5 * sin (0.001 * (i + j));
+			postMotion (scene.window, x0 + pos * slider->getWidth (), y0);
+		}
+		scene.window->handleEvents ();
+		times.push_back (now () - t0);
+	}
+
+	postButton (scene.window, PUGL_BUTTON_RELEASE, x0, y0);
+	scene.window->handleEvents ();
+
+	reportPasses ("drag", std::to_string (eventsPerPass) + " motions/pass", times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+}
+
+/**
+ * Dial automation: All dials of a 100 widget tree automated at 1 kHz for
+ * one second (real time) with a maximum frame rate of 60 Hz.
+ */
+static void benchAutomation ()
+{
+	const int ticks = 1000;
+
+	Scene scene (100);
+	scene.window->setFrameRate (60.0);
+	scene.window->handleEvents ();
+	scene.window->resetFrameStatistics ();
+
+	std::vector<double> times;
+	long allocs = allocations;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+
+	for (int i = 0; i < ticks; ++i)
+	{
+		std::this_thread::sleep_until (start + std::chrono::milliseconds (i));
+		double t0 = now ();
+		for (size_t j = 0; j < scene.dials.size (); ++j) scene.dials[j]->setValue (0.5 + 0.5 * sin (0.01 * i + j));
+		scene.window->handleEvents ();
+		times.push_back (now () - t0);
+	}
+
+	reportPasses ("automation", std::to_string (scene.dials.size ()) + " dials at 1 kHz", times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+	std::cout << "automation\t" << scene.window->getFrameStatistics ().frames << " frames rendered within " << ticks << " ms" << std::endl;
+}
+
+/**
+ * Full-window resize: Alternating configure events between the full and
+ * 3/4 of the window size of a 1000 widget tree.
+ */
+static void benchResize ()
+{
+	const int runs = 50;
+
+	Scene scene (1000);
+	scene.window->handleEvents ();
+	scene.window->resetFrameStatistics ();
+	const double width = scene.window->getWidth ();
+	const double height = scene.window->getHeight ();
+
+	std::vector<double> times;
+	long allocs = allocations;
+
+	for (int i = 0; i < runs; ++i)
+	{
+		double t0 = now ();
+		double f = (i & 1 ? 1.0 : 0.75);
+		postConfigure (scene.window, f * width, f * height);
+		scene.window->handleEvents ();
+		times.push_back (now () - t0);
+	}
+
+	reportPasses ("resize", std::to_string (int (width)) + "x" + std::to_string (int (height)), times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+}
+
+/**
+ * Theme application: Alternating application of two themes to all widgets
+ * of trees of 100 and 1000 widgets.
+ */
+static void benchTheme ()
+{
+	const int runs = 20;
+	BColors::ColorSet greenColors = {{{0.0, 0.75, 0.2, 1.0}, {0.0, 1.0, 0.4, 1.0}, {0.0, 0.2, 0.0, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
+	BColors::ColorSet blueColors = {{{0.0, 0.2, 0.75, 1.0}, {0.0, 0.4, 1.0, 1.0}, {0.0, 0.0, 0.2, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
+	BStyles::Border frameBorder = {BStyles::whiteLine1pt, 3.0, 3.0, 10.0};
+	std::array<BStyles::Theme, 2> themes;
+
+	for (int i = 0; i < 2; ++i)
+	{
+		BColors::ColorSet* fgColors = (i == 0 ? &greenColors : &blueColors);
+		themes[i] = BStyles::Theme ({
+			{"Slider", {{"fgcolors", STYLEPTR (fgColors)}, {"bgcolors", STYLEPTR (&BColors::greys)}}},
+			{"Dial", {{"fgcolors", STYLEPTR (fgColors)}, {"bgcolors", STYLEPTR (&BColors::greys)}}},
+			{"Button", {{"buttoncolors", STYLEPTR (fgColors)}, {"bgcolors", STYLEPTR (&BColors::darks)}}},
+			{"Label", {{"textcolors", STYLEPTR (fgColors)}, {"border", STYLEPTR (&frameBorder)}}}
+		});
+	}
+
+	for (int n : {100, 1000})
+	{
+		Scene scene (n);
+		scene.window->handleEvents ();
+		scene.window->resetFrameStatistics ();
+
+		std::vector<double> times;
+		long allocs = allocations;
+
+		for (int i = 0; i < runs; ++i)
+		{
+			double t0 = now ();
+			for (BWidgets::Widget* w : scene.widgets) w->applyTheme (themes[i & 1]);
+			scene.window->handleEvents ();
+			times.push_back (now () - t0);
+		}
+
+		reportPasses ("theme", std::to_string (n) + " widgets", times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+	}
+}
+
+/**
+ * Event throughput: 100000 pointer motion events. Compares the former event
+ * queue (std::vector with erase at the front, events allocated from the
+ * heap) with BEvents::EventQueue and pooled events for 100 queued events
+ * per pass. Then passes the events as Pugl events through an offscreen
+ * window with 100 widgets which don't or do consume pointer motion events.
+ */
+static void benchEvents ()
+{
+	const int nrEvents = 100000;
+	const int eventsPerPass = 100;
+	const int passes = nrEvents / eventsPerPass;
+
+	// Former queue
+	std::vector<BEvents::Event*> vectorQueue;
+	long allocs = allocations;
+	double t0 = now ();
+	for (int i = 0; i < passes; ++i)
+	{
+		for (int j = 0; j < eventsPerPass; ++j)
+		{
+			vectorQueue.push_back (::new BEvents::PointerEvent (nullptr, BEvents::POINTER_MOTION_EVENT, j, j, 1, 1, BEvents::NO_BUTTON));
+		}
+
+		while (vectorQueue.size () > 0)
+		{
+			::delete vectorQueue.front ();
+			vectorQueue.erase (vectorQueue.begin ());
+		}
+	}
+	double t = now () - t0;
+	std::cout << "events\tvector + heap\t" << nrEvents * 1000000.0 / t << " events/s\t"
+			  << double (allocations - allocs) / nrEvents << " allocs/event" << std::endl;
+
+	// Ring buffer and event pool
+	BEvents::EventQueue ringQueue;
+	allocs = allocations;
+	t0 = now ();
+	for (int i = 0; i < passes; ++i)
+	{
+		for (int j = 0; j < eventsPerPass; ++j)
+		{
+			ringQueue.push (new BEvents::PointerEvent (nullptr, BEvents::POINTER_MOTION_EVENT, j, j, 1, 1, BEvents::NO_BUTTON));
+		}
+
+		while (!ringQueue.empty ())
+		{
+			delete ringQueue.front ();
+			ringQueue.pop ();
+		}
+	}
+	t = now () - t0;
+	std::cout << "events\tring buffer + pool\t" << nrEvents * 1000000.0 / t << " events/s\t"
+			  << double (allocations - allocs) / nrEvents << " allocs/event" << std::endl;
+
+	// Window without and with widgets consuming pointer motion events
+	for (bool consumers : {false, true})
+	{
+		Scene scene (100);
+		if (!consumers)
+		{
+			for (BWidgets::Widget* w : scene.widgets) w->setEventInterest (BEvents::POINTER_MOTION_EVENT, false);
+			scene.window->setEventInterest (BEvents::POINTER_MOTION_EVENT, false);
+		}
+		scene.window->handleEvents ();
+		const double width = scene.window->getWidth ();
+		const double height = scene.window->getHeight ();
+
+		std::vector<double> times;
+		allocs = allocations;
+		t0 = now ();
+		for (int i = 0; i < passes; ++i)
+		{
+			double t1 = now ();
+			for (int j = 0; j < eventsPerPass; ++j)
+			{
+				int n = i * eventsPerPass + j;
+				postMotion (scene.window, fmod (0.37 * n, width), fmod (0.61 * n, height));
+			}
+			scene.window->handleEvents ();
+			times.push_back (now () - t1);
+		}
+		t = now () - t0;
+
+		std::string variant = (consumers ? "window, motion consumers" : "window, no motion consumers");
+		reportPasses ("events", variant, times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+		std::cout << "events\t" << variant << "\t" << nrEvents * 1000000.0 / t << " events/s" << std::endl;
+	}
+}
+
+static long deliveredValueChanges = 0;
+static void countValueChanged (BEvents::Event*) {++deliveredValueChanges;}
+
+/**
+ * Value change burst: 10 value changes of each dial of a 100 widget tree
+ * per pass with and without value changed coalescing. Reports the passes,
+ * the delivered value changed events and the superseded events.
+ */
+static void benchValueChanges ()
+{
+	const int passes = 100;
+	const int changesPerPass = 10;
+
+	for (bool coalescing : {false, true})
+	{
+		Scene scene (100);
+		for (BWidgets::Dial* d : scene.dials) d->setCallbackFunction (BEvents::VALUE_CHANGED_EVENT, countValueChanged);
+		scene.window->setValueChangedCoalescing (coalescing);
+		scene.window->handleEvents ();
+		scene.window->resetFrameStatistics ();
+
+		std::vector<double> times;
+		long allocs = allocations;
+		deliveredValueChanges = 0;
+
+		for (int i = 0; i < passes; ++i)
+		{
+			double t0 = now ();
+			for (int j = 0; j < changesPerPass; ++j)
+			{
+				for (size_t k = 0; k < scene.dials.size (); ++k) scene.dials[k]->setValue (0.5 + 0.5 * sin (0.1 * (i * changesPerPass + j) + k));
+			}
+			scene.window->handleEvents ();
+			times.push_back (now () - t0);
+		}
+
+		std::string variant = (coalescing ? "coalescing" : "no coalescing");
+		reportPasses ("valuechanges", variant, times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+		std::cout << "valuechanges\t" << variant << "\t" << deliveredValueChanges << " delivered\t"
+				  << scene.window->getFrameStatistics ().supersededValueChanges << " superseded" << std::endl;
+	}
+}
+
+/**
+ * Hit testing: 10000 pointer motion events at pseudo-random positions of
+ * windows with 1000 and 10000 widgets (which consume pointer motion events
+ * by default). Each motion event is hit-tested. Then the same after moving a
+ * widget before each event (rebuild of the hit testing grid).
+ */
+static void benchHitTest ()
+{
+	const int nrEvents = 10000;
+	const int eventsPerPass = 10;
+
+	for (int n : {1000, 10000})
+	{
+		for (bool moving : {false, true})
+		{
+			Scene scene (n);
+			scene.window->handleEvents ();
+			scene.window->resetFrameStatistics ();
+			const double width = scene.window->getWidth ();
+			const double height = scene.window->getHeight ();
+			BWidgets::Widget* moved = scene.widgets.front ();
+
+			std::vector<double> times;
+			long allocs = allocations;
+
+			for (int i = 0; i < nrEvents; i += eventsPerPass)
+			{
+				double t0 = now ();
+				for (int j = 0; j < eventsPerPass; ++j)
+				{
+					if (moving) moved->moveTo ((i + j) & 1, 0);
+					postMotion (scene.window, fmod (7.31 * (i + j), width), fmod (3.17 * (i + j), height));
+				}
+				scene.window->handleEvents ();
+				times.push_back (now () - t0);
+			}
+
+			std::string variant = std::to_string (n) + " widgets" + (moving ? ", moving widget" : "");
+			reportPasses ("hittest", variant, times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+		}
+	}
+}
+
+/**
+ * Filmstrip cache: Value changes of 250 dials (40x40) per pass with the
+ * filmstrip cache disabled and with 256 frames. The first pass with the
+ * filmstrip cache also renders the frames.
+ */
+static void benchFilmstrip ()
+{
+	const int passes = 500;
+
+	for (int frames : {0, 256})
+	{
+		Scene scene (1000);
+		for (BWidgets::Dial* d : scene.dials) d->setFilmstripFrames (frames);
+		scene.window->handleEvents ();
+		scene.window->resetFrameStatistics ();
+
+		std::vector<double> times;
+		long allocs = allocations;
+
+		for (int i = 0; i < passes; ++i)
+		{
+			double t0 = now ();
+			for (size_t j = 0; j < scene.dials.size (); ++j) scene.dials[j]->setValue (0.5 + 0.5 * sin (0.05 * i + j));
+			scene.window->handleEvents ();
+			times.push_back (now () - t0);
+		}
+
+		std::string variant = std::to_string (scene.dials.size ()) + " dials, " + (frames ? std::to_string (frames) + " filmstrip frames" : "no filmstrip");
+		reportPasses ("filmstrip", variant, times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+	}
+}
+
+/**
+ * Parallel drawing: Value changes of all 750 value widgets of a 1000 widget
+ * tree per pass, drawn single-threaded and on a pool of worker threads.
+ */
+static void benchDrawingThreads ()
+{
+	const int passes = 200;
+	const int nrThreads = (std::thread::hardware_concurrency () > 1 ? std::thread::hardware_concurrency () - 1 : 1);
+
+	Scene scene (1000);
+	scene.window->handleEvents ();
+
+	for (int threads : {0, nrThreads})
+	{
+		scene.window->setDrawingThreads (threads);
+		scene.window->resetFrameStatistics ();
+		std::vector<double> times;
+		long allocs = allocations;
+
+		for (int i = 0; i < passes; ++i)
+		{
+			double t0 = now ();
+			for (BWidgets::ValueWidget* v : scene.values) v->setValue ((i & 1) ? 1.0 : 0.0);
+			scene.window->handleEvents ();
+			times.push_back (now () - t0);
+		}
+
+		std::string variant = std::to_string (scene.values.size ()) + " widgets" +
+							  (threads ? " drawn on " + std::to_string (threads + 1) + " threads" : " single-threaded");
+		reportPasses ("drawingthreads", variant, times, scene.window->getFrameStatistics ().frames, allocations - allocs);
+	}
+}
+
+int main (int argc, char* argv[])
+{
+	// Select scenario by the first argument or run all scenarios
+	std::string scenario = (argc > 1 ? argv[1] : "all");
+
+	if ((scenario == "all") || (scenario == "backbuffer")) benchBackBuffer ();
+	if ((scenario == "all") || (scenario == "origin")) benchOrigin ();
+	if ((scenario == "all") || (scenario == "tiles")) benchTiles ();
+	if ((scenario == "all") || (scenario == "draw")) benchDraw ();
+	if ((scenario == "all") || (scenario == "startup")) benchStartup ();
+	if ((scenario == "all") || (scenario == "tree")) benchTree ();
+	if ((scenario == "all") || (scenario == "drag")) benchDrag ();
+	if ((scenario == "all") || (scenario == "automation")) benchAutomation ();
+	if ((scenario == "all") || (scenario == "resize")) benchResize ();
+	if ((scenario == "all") || (scenario == "theme")) benchTheme ();
+	if ((scenario == "all") || (scenario == "events")) benchEvents ();
+	if ((scenario == "all") || (scenario == "valuechanges")) benchValueChanges ();
+	if ((scenario == "all") || (scenario == "hittest")) benchHitTest ();
+	if ((scenario == "all") || (scenario == "filmstrip")) benchFilmstrip ();
+	if ((scenario == "all") || (scenario == "drawingthreads")) benchDrawingThreads ();
+
+	return 0;
+}
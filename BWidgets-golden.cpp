@@ -0,0 +1,430 @@
+#include "BWidgets/BWidgets.hpp"
+#include <functional>
+#include <array>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+/**
+ * Golden image regression test: Renders each widget exported by BWidgets.hpp
+ * under each theme of BWidgets-demo (and without theme) into an offscreen
+ * window at the default (demo) size and at half and double size. Each frame
+ * is compared with a golden image (PNG) in the test data directory. On a
+ * mismatch, a *-diff.png is written next to the golden image and the test
+ * fails. Missing golden images are only created if called with --generate.
+ * Then each widget is changed after its first frame (value, size and theme)
+ * and the updated frame is compared with a fresh render of a new widget in
+ * the same state. This covers the partial redraws and the widget caches.
+ *
+ * Usage: golden [--generate] [directory]
+ *
+ * If built with GOLDEN_BASELINE against the baseline tree (see make goldens),
+ * the golden images are (re)generated from the baseline rendering instead.
+ * The baseline has no offscreen window and thus needs an X display.
+ */
+
+// Maximum difference per color channel (0..255) of pixels to be considered
+// as equal. Compensates minor rasterization and font rendering differences.
+static const int GOLDEN_TOLERANCE = 8;
+
+static const std::string GOLDEN_DIRECTORY = "tests/golden";
+
+/**
+ * Test case: A widget class with the style set used in BWidgets-demo and its
+ * default (demo) size.
+ */
+struct GoldenCase
+{
+	std::string name;
+	std::string style;
+	double width;
+	double height;
+	std::function<BWidgets::Widget* (const double width, const double height, const std::string& style)> create;
+};
+
+static const std::vector<GoldenCase> goldenCases =
+{
+	{"Widget", "Frame", 460, 260, [] (double w, double h, const std::string& s) {return new BWidgets::Widget (0, 0, w, h, s);}},
+	{"Label", "Label", 340, 16, [] (double w, double h, const std::string&)
+		{return new BWidgets::Label (0, 0, w, h, "This is a long text and it will be hidden partially!");}},
+	{"Text", "Text", 160, 80, [] (double w, double h, const std::string&)
+		{return new BWidgets::Text (0, 0, w, h, "This is a text.\nThis text contains line breaks if the text is too long.");}},
+	{"ValueWidget", "Widget", 80, 80, [] (double w, double h, const std::string& s) {return new BWidgets::ValueWidget (0, 0, w, h, s, 80.0);}},
+	{"RangeWidget", "Widget", 80, 80, [] (double w, double h, const std::string& s)
+		{return new BWidgets::RangeWidget (0, 0, w, h, s, 80.0, 0.0, 100.0, 0.0);}},
+	{"HSlider", "Slider", 240, 20, [] (double w, double h, const std::string& s)
+		{return new BWidgets::HSlider (0, 0, w, h, s, 80.0, 0.0, 100.0, 0.0);}},
+	{"VSlider", "Slider", 20, 240, [] (double w, double h, const std::string& s)
+		{return new BWidgets::VSlider (0, 0, w, h, s, 80.0, 0.0, 100.0, 0.0);}},
+	{"Dial", "Dial", 80, 80, [] (double w, double h, const std::string& s)
+		{return new BWidgets::Dial (0, 0, w, h, s, 80.0, 0.0, 100.0, 0.0);}},
+	{"HSliderWithValueDisplay", "DialVal", 240, 40, [] (double w, double h, const std::string& s)
+		{return new BWidgets::HSliderWithValueDisplay (0, 0, w, h, s, 80.0, 0.0, 100.0, 0.0, "%3.1f");}},
+	{"VSliderWithValueDisplay", "DialVal", 40, 240, [] (double w, double h, const std::string& s)
+		{return new BWidgets::VSliderWithValueDisplay (0, 0, w, h, s, 80.0, 0.0, 100.0, 1.0, "%3.1f");}},
+	{"DialWithValueDisplay", "DialVal", 80, 80, [] (double w, double h, const std::string& s)
+		{return new BWidgets::DialWithValueDisplay (0, 0, w, h, s, 80.0, 0.0, 100.0, 1.0, "%4.0f");}},
+	{"Button", "Button", 60, 20, [] (double w, double h, const std::string& s) {return new BWidgets::Button (0, 0, w, h, s, 0.0);}},
+	{"ToggleButton", "Button", 60, 20, [] (double w, double h, const std::string& s) {return new BWidgets::ToggleButton (0, 0, w, h, s, 1.0);}},
+	{"TextButton", "Button", 60, 20, [] (double w, double h, const std::string& s) {return new BWidgets::TextButton (0, 0, w, h, s, 0.0);}},
+	{"TextToggleButton", "Button", 60, 20, [] (double w, double h, const std::string& s)
+		{return new BWidgets::TextToggleButton (0, 0, w, h, s, 1.0);}},
+	{"HSwitch", "Switch", 40, 20, [] (double w, double h, const std::string& s) {return new BWidgets::HSwitch (0, 0, w, h, s, 1.0);}},
+	{"VSwitch", "Switch", 20, 40, [] (double w, double h, const std::string& s) {return new BWidgets::VSwitch (0, 0, w, h, s, 0.0);}},
+	{"DrawingSurface", "Surface", 320, 75, [] (double w, double h, const std::string& s) {return new BWidgets::DrawingSurface (0, 0, w, h, s);}}
+};
+
+static const std::array<double, 3> goldenScales = {{1.0, 0.5, 2.0}};
+
+// Size of the updated widgets relative to their default size
+static const double UPDATE_SCALE = 1.5;
+
+/**
+ * Paints the content of drawing surface widgets. Has to be repeated after
+ * each change of the size or the border (which discards the content).
+ * @param widget Widget
+ */
+static void paintContent (BWidgets::Widget* widget)
+{
+	BWidgets::DrawingSurface* surface = dynamic_cast<BWidgets::DrawingSurface*> (widget);
+	if (!surface) return;
+
+	cairo_surface_t* s = surface->getDrawingSurface ();
+	double width = cairo_image_surface_get_width (s);
+	double height = cairo_image_surface_get_height (s);
+	cairo_t* cr = cairo_create (s);
+	cairo_set_line_width (cr, 3.0);
+	cairo_set_source_rgba (cr, 1.0, 1.0, 0.0, 1.0);
+	cairo_arc (cr, 0.5 * width, 0.5 * height, 0.4 * (width < height ? width : height), 0, 2 * M_PI);
+	cairo_close_path (cr);
+	cairo_fill_preserve (cr);
+	cairo_set_source_rgba (cr, 0.0, 0.0, 0.0, 1.0);
+	cairo_stroke (cr);
+	cairo_destroy (cr);
+	surface->update ();
+}
+
+/**
+ * Changes the value of value widgets: Range widgets to 20 % of their range,
+ * other value widgets toggle between 0 and 1.
+ * @param widget Widget
+ */
+static void changeValue (BWidgets::Widget* widget)
+{
+	BWidgets::RangeWidget* range = dynamic_cast<BWidgets::RangeWidget*> (widget);
+	BWidgets::ValueWidget* value = dynamic_cast<BWidgets::ValueWidget*> (widget);
+	if (range) range->setValue (range->getMin () + 0.2 * (range->getMax () - range->getMin ()));
+	else if (value) value->setValue (value->getValue () == 0.0 ? 1.0 : 0.0);
+}
+
+/**
+ * Creates a widget of a test case, applies a theme (if not nullptr) and
+ * paints its content.
+ */
+static BWidgets::Widget* createWidget (const GoldenCase& goldenCase, BStyles::Theme* theme, const int width, const int height)
+{
+	BWidgets::Widget* widget = goldenCase.create (width, height, goldenCase.style);
+	if (theme) widget->applyTheme (*theme, goldenCase.style);
+	paintContent (widget);
+	return widget;
+}
+
+static BWidgets::Window* createWindow (BStyles::Theme* theme, const int width, const int height)
+{
+#ifdef GOLDEN_BASELINE
+	BWidgets::Window* window = new BWidgets::Window (width, height, "Window", 0);
+#else
+	BWidgets::Window* window = new BWidgets::Window (width, height, "Window");
+#endif
+	if (theme) window->applyTheme (*theme);
+	return window;
+}
+
+#ifdef GOLDEN_BASELINE
+/**
+ * Makes the protected Widget::redisplay accessible to copy the content of
+ * the baseline window (which renders into a Pugl view only).
+ */
+class GoldenAccess : public BWidgets::Widget
+{
+public:
+	static void copy (BWidgets::Widget* widget, cairo_surface_t* surface)
+	{
+		void (BWidgets::Widget::*member) (cairo_surface_t*, double, double, double, double) = &GoldenAccess::redisplay;
+		(widget->*member) (surface, 0, 0, widget->getWidth (), widget->getHeight ());
+	}
+};
+#endif
+
+/**
+ * Renders all pending changes of a window and copies the resulting frame.
+ * @param window Window
+ * @return New ARGB32 image surface with the frame, has to be destroyed
+ */
+static cairo_surface_t* renderFrame (BWidgets::Window* window)
+{
+	cairo_surface_t* frame = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, window->getWidth (), window->getHeight ());
+
+#ifdef GOLDEN_BASELINE
+	// Baseline widgets are drawn immediately
+	GoldenAccess::copy (window, frame);
+#else
+	window->run ();
+	cairo_t* cr = cairo_create (frame);
+	cairo_set_source_surface (cr, window->getOffscreenSurface (), 0, 0);
+	cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+	cairo_paint (cr);
+	cairo_destroy (cr);
+#endif
+
+	return frame;
+}
+
+/**
+ * Renders a widget into a window of the same size.
+ * @return New ARGB32 image surface with the frame, has to be destroyed
+ */
+static cairo_surface_t* renderWidget (const GoldenCase& goldenCase, BStyles::Theme* theme, const int width, const int height)
+{
+	BWidgets::Window* window = createWindow (theme, width, height);
+	BWidgets::Widget* widget = createWidget (goldenCase, theme, width, height);
+	window->add (*widget);
+	cairo_surface_t* frame = renderFrame (window);
+	delete widget;
+	delete window;
+	return frame;
+}
+
+#ifndef GOLDEN_BASELINE
+/**
+ * Compares a frame with a reference image. Writes a diff image if they
+ * differ.
+ * @param name Name of the test
+ * @param diffPath Path of the diff image (without extension)
+ * @return TRUE if the frame matches the reference, otherwise FALSE
+ */
+static bool compareFrame (cairo_surface_t* frame, cairo_surface_t* reference, const std::string& name, const std::string& diffPath)
+{
+	cairo_surface_t* diff = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, cairo_image_surface_get_width (frame), cairo_image_surface_get_height (frame));
+	int count = cairo_image_surface_compare (frame, reference, GOLDEN_TOLERANCE, diff);
+
+	if (count == 0) std::cout << "ok\t" << name << std::endl;
+	else
+	{
+		if (count > 0) cairo_surface_write_to_png (diff, (diffPath + "-diff.png").c_str ());
+		std::cout << "FAILED\t" << name << "\t"
+				  << (count > 0 ? std::to_string (count) + " pixels differ, see " + diffPath + "-diff.png" : "images can't be compared")
+				  << std::endl;
+	}
+
+	cairo_surface_destroy (diff);
+	return (count == 0);
+}
+
+/**
+ * Renders a widget into an offscreen window and compares the frame with its
+ * golden image.
+ * @param path Path of the golden image without extension
+ * @param generate If true, a missing golden image is created
+ * @return TRUE if the frame matches the golden image (or if the golden
+ * 		   image was created), otherwise FALSE
+ */
+static bool checkGolden (const GoldenCase& goldenCase, BStyles::Theme* theme, const int width, const int height,
+						 const std::string& path, const bool generate)
+{
+	cairo_surface_t* frame = renderWidget (goldenCase, theme, width, height);
+	cairo_surface_t* golden = cairo_image_surface_create_from_png ((path + ".png").c_str ());
+	bool result = false;
+
+	if (cairo_surface_status (golden) == CAIRO_STATUS_FILE_NOT_FOUND)
+	{
+		if (generate && (cairo_surface_write_to_png (frame, (path + ".png").c_str ()) == CAIRO_STATUS_SUCCESS))
+		{
+			std::cout << "generated\t" << path << ".png" << std::endl;
+			result = true;
+		}
+		else std::cout << "MISSING\t" << path << ".png" << std::endl;
+	}
+
+	else result = compareFrame (frame, golden, path + ".png", path);
+
+	cairo_surface_destroy (golden);
+	cairo_surface_destroy (frame);
+	return result;
+}
+
+/**
+ * Renders a widget without theme at its default size, then changes its
+ * value, resizes it and applies a theme. Compares the updated frame with a
+ * fresh render of a new widget in the same state.
+ * @param theme Theme applied after the first frame
+ * @param path Path of the diff image (without extension)
+ * @return TRUE if the frames match, otherwise FALSE
+ */
+static bool checkUpdate (const GoldenCase& goldenCase, BStyles::Theme* theme, const std::string& path)
+{
+	const int width = std::max (int (round (goldenCase.width)), 1);
+	const int height = std::max (int (round (goldenCase.height)), 1);
+	const int newWidth = std::max (int (round (UPDATE_SCALE * goldenCase.width)), 1);
+	const int newHeight = std::max (int (round (UPDATE_SCALE * goldenCase.height)), 1);
+
+	// Updated widget
+	BWidgets::Window* window = createWindow (nullptr, newWidth, newHeight);
+	BWidgets::Widget* widget = createWidget (goldenCase, nullptr, width, height);
+	window->add (*widget);
+	cairo_surface_destroy (renderFrame (window));
+
+	changeValue (widget);
+	widget->setWidth (newWidth);
+	widget->setHeight (newHeight);
+	window->applyTheme (*theme);
+	widget->applyTheme (*theme, goldenCase.style);
+	paintContent (widget);
+	cairo_surface_t* frame = renderFrame (window);
+
+	// Fresh widget in the same state
+	BWidgets::Window* freshWindow = createWindow (theme, newWidth, newHeight);
+	BWidgets::Widget* freshWidget = goldenCase.create (newWidth, newHeight, goldenCase.style);
+	changeValue (freshWidget);
+	freshWidget->applyTheme (*theme, goldenCase.style);
+	paintContent (freshWidget);
+	freshWindow->add (*freshWidget);
+	cairo_surface_t* fresh = renderFrame (freshWindow);
+
+	bool result = compareFrame (frame, fresh, "update " + goldenCase.name, path);
+
+	cairo_surface_destroy (fresh);
+	cairo_surface_destroy (frame);
+	delete freshWidget;
+	delete freshWindow;
+	delete widget;
+	delete window;
+	return result;
+}
+#endif
+
+int main (int argc, char* argv[])
+{
+	bool generate = false;
+	std::string directory = GOLDEN_DIRECTORY;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--generate") generate = true;
+		else directory = arg;
+	}
+
+#ifdef GOLDEN_BASELINE
+	if (!generate)
+	{
+		std::cerr << "The baseline build only generates golden images (--generate)" << std::endl;
+		return EXIT_FAILURE;
+	}
+#endif
+
+	// Theme of BWidgets-demo
+	BColors::ColorSet defaultFgColors = {{{0.0, 0.75, 0.2, 1.0}, {0.0, 1.0, 0.4, 1.0}, {0.0, 0.2, 0.0, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
+	BColors::ColorSet defaultToolColors = BColors::greys;
+
+	BStyles::StyleSet defaultStyles = {"Widget", {{"background", STYLEPTR (&BStyles::noFill)},
+											 	  {"border", STYLEPTR (&BStyles::noBorder)}}};
+
+	BStyles::Border frameBorder = {BStyles::whiteLine1pt, 3.0, 3.0, 10.0};
+
+	BStyles::Font defaultFont = BStyles::Font ("Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL, 12.0,
+											   BStyles::TEXT_ALIGN_CENTER, BStyles::TEXT_VALIGN_MIDDLE);
+
+	BStyles::Theme demoTheme = BStyles::Theme ({
+		defaultStyles,
+		{"Window", {{"background", STYLEPTR (&BStyles::blackFill)},
+					{"border", STYLEPTR (&BStyles::noBorder)}}
+		},
+		{"Frame", {{"background", STYLEPTR (&BStyles::greyFill)},
+				   {"border", STYLEPTR (&frameBorder)}}
+		},
+		{"Surface", {{"background", STYLEPTR (&BStyles::redFill)},
+					 {"border", STYLEPTR (&frameBorder)}}
+		},
+		{"Label", {{"uses", STYLEPTR (&defaultStyles)},
+				   {"textcolors", STYLEPTR (&BColors::blues)},
+				   {"font", STYLEPTR (&defaultFont)}}
+		},
+		{"Text", {{"uses", STYLEPTR (&defaultStyles)},
+				   {"border", STYLEPTR (&frameBorder)},
+				   {"textcolors", STYLEPTR (&BColors::whites)},
+				   {"font", STYLEPTR (&defaultFont)}}
+		},
+		{"Slider", {{"uses", STYLEPTR (&defaultStyles)},
+					{"fgcolors", STYLEPTR (&defaultFgColors)},
+					{"bgcolors", STYLEPTR (&defaultToolColors)}}
+		},
+		{"Dial", {{"uses", STYLEPTR (&defaultStyles)},
+				  {"fgcolors", STYLEPTR (&defaultFgColors)},
+				  {"bgcolors", STYLEPTR (&defaultToolColors)}}
+		},
+		{"DialVal", {{"uses", STYLEPTR (&defaultStyles)},
+			   	     {"fgcolors", STYLEPTR (&defaultFgColors)},
+					 {"bgcolors", STYLEPTR (&defaultToolColors)},
+					 {"textcolors", STYLEPTR (&BColors::darks)},
+					 {"font", STYLEPTR (&defaultFont)}}
+		},
+		{"Button", {{"uses", STYLEPTR (&defaultStyles)},
+					{"buttoncolors", STYLEPTR (&BColors::darks)},
+					{"bgcolors", STYLEPTR (&BColors::darks)},
+					{"textcolors", STYLEPTR (&defaultFgColors)},
+					{"font", STYLEPTR (&defaultFont)}}
+		},
+		{"Switch", {{"uses", STYLEPTR (&defaultStyles)},
+					{"buttoncolors", STYLEPTR (&BColors::darks)},
+					{"bgcolors", STYLEPTR (&BColors::darks)},
+					{"labelcolors", STYLEPTR (&defaultFgColors)}}
+		}
+	});
+
+	// Built-in widget styles (no theme) and the demo theme
+	std::vector<std::pair<std::string, BStyles::Theme*>> themes = {{"plain", nullptr}, {"demo", &demoTheme}};
+
+	int failed = 0;
+	int total = 0;
+	for (std::pair<std::string, BStyles::Theme*>& theme : themes)
+	{
+		for (const GoldenCase& goldenCase : goldenCases)
+		{
+			for (double scale : goldenScales)
+			{
+				int width = std::max (int (round (scale * goldenCase.width)), 1);
+				int height = std::max (int (round (scale * goldenCase.height)), 1);
+				std::string path = directory + "/" + theme.first + "-" + goldenCase.name + "-" +
+								   std::to_string (width) + "x" + std::to_string (height);
+
+#ifdef GOLDEN_BASELINE
+				cairo_surface_t* frame = renderWidget (goldenCase, theme.second, width, height);
+				if (cairo_surface_write_to_png (frame, (path + ".png").c_str ()) == CAIRO_STATUS_SUCCESS)
+				{
+					std::cout << "generated\t" << path << ".png" << std::endl;
+				}
+				else
+				{
+					std::cout << "FAILED\t" << path << ".png can't be written" << std::endl;
+					++failed;
+				}
+				cairo_surface_destroy (frame);
+#else
+				if (!checkGolden (goldenCase, theme.second, width, height, path, generate)) ++failed;
+#endif
+				++total;
+			}
+		}
+	}
+
+#ifndef GOLDEN_BASELINE
+	for (const GoldenCase& goldenCase : goldenCases)
+	{
+		if (!checkUpdate (goldenCase, &demoTheme, directory + "/update-" + goldenCase.name)) ++failed;
+		++total;
+	}
+#endif
+
+	std::cout << (total - failed) << " of " << total << " golden image tests passed" << std::endl;
+	return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,101 @@
+#include "BWidgets/BWidgets.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <dlfcn.h>
+
+/**
+ * Leak test of the cairo patterns used by the widgets: Counts the live
+ * linear and radial patterns across 10000 redraws of each widget class using
+ * patterns. Fails if the number of live patterns grows while redrawing or if
+ * patterns aren't finalized with the widget.
+ */
+
+/**
+ * Counter of live linear and radial cairo patterns. The cairo pattern
+ * constructors are interposed to attach a destroy notifier to each pattern
+ * created by BWidgets. The notifier is called by cairo when the pattern is
+ * finalized (its last reference is released), whoever releases it.
+ */
+static std::atomic<long> livePatterns (0);
+static cairo_user_data_key_t patternKey;
+
+static void patternFinalized (void*) {--livePatterns;}
+
+static cairo_pattern_t* trackPattern (cairo_pattern_t* pattern)
+{
+	if (cairo_pattern_set_user_data (pattern, &patternKey, nullptr, patternFinalized) == CAIRO_STATUS_SUCCESS) ++livePatterns;
+	return pattern;
+}
+
+extern "C"
+{
+cairo_pattern_t* cairo_pattern_create_linear (double x0, double y0, double x1, double y1)
+{
+	static auto func = (cairo_pattern_t* (*) (double, double, double, double)) dlsym (RTLD_NEXT, "cairo_pattern_create_linear");
+	return trackPattern (func (x0, y0, x1, y1));
+}
+
+cairo_pattern_t* cairo_pattern_create_radial (double cx0, double cy0, double radius0, double cx1, double cy1, double radius1)
+{
+	static auto func = (cairo_pattern_t* (*) (double, double, double, double, double, double)) dlsym (RTLD_NEXT, "cairo_pattern_create_radial");
+	return trackPattern (func (cx0, cy0, radius0, cx1, cy1, radius1));
+}
+}
+
+/**
+ * Makes the protected draw method of a widget class accessible.
+ */
+template<class T> class Drawable : public T
+{
+public:
+	using T::T;
+	void redraw () {this->draw (0, 0, this->getWidth (), this->getHeight ());}
+};
+
+/**
+ * Redraws a widget with alternating values and checks that the number of
+ * live cairo patterns stays constant after the first redraws and that all
+ * patterns are finalized with the widget.
+ * @param name Name of the test
+ * @param widget Widget to be redrawn (will be deleted)
+ * @param runs Number of redraws
+ * @return TRUE if no pattern leaked, otherwise FALSE
+ */
+template<class T> static bool checkPatterns (const std::string& name, Drawable<T>* widget, const int runs)
+{
+	const long before = livePatterns;
+	widget->redraw ();
+	widget->setValue (widget->getValue () == 0.0 ? 1.0 : 0.0);
+	widget->redraw ();
+	const long cached = livePatterns - before;
+
+	for (int i = 0; i < runs; ++i)
+	{
+		widget->setValue (i & 1);
+		widget->redraw ();
+	}
+	const long after = livePatterns - before;
+	delete widget;
+	const long released = livePatterns - before;
+
+	bool result = (after == cached) && (released == 0);
+	std::cout << (result ? "ok" : "FAILED") << "\t" << name << "\t" << cached << " cached, " << after << " live after "
+			  << runs << " redraws, " << released << " live after destruction" << std::endl;
+	return result;
+}
+
+int main ()
+{
+	const int runs = 10000;
+	int failed = 0;
+
+	if (!checkPatterns ("dial", new Drawable<BWidgets::Dial> (0, 0, 80, 80, "dial", 0.0, 0.0, 1.0, 0.0), runs)) ++failed;
+	if (!checkPatterns ("hslider", new Drawable<BWidgets::HSlider> (0, 0, 200, 40, "hslider", 0.0, 0.0, 1.0, 0.0), runs)) ++failed;
+	if (!checkPatterns ("vslider", new Drawable<BWidgets::VSlider> (0, 0, 40, 200, "vslider", 0.0, 0.0, 1.0, 0.0), runs)) ++failed;
+	if (!checkPatterns ("button", new Drawable<BWidgets::Button> (0, 0, 60, 30, "button", 0.0), runs)) ++failed;
+	if (!checkPatterns ("hswitch", new Drawable<BWidgets::HSwitch> (0, 0, 60, 30, "hswitch", 0.0), runs)) ++failed;
+	if (!checkPatterns ("vswitch", new Drawable<BWidgets::VSwitch> (0, 0, 30, 60, "vswitch", 0.0), runs)) ++failed;
+
+	std::cout << (6 - failed) << " of 6 pattern leak tests passed" << std::endl;
+	return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
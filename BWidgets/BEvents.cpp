@@ -23,8 +23,75 @@ namespace BEvents
  * Class BEvents::Event
  *****************************************************************************/
 
+// Event pool: free lists for event objects in steps of 16 bytes up to 128 bytes
+namespace
+{
+const size_t POOL_GRANULARITY = 16;
+const size_t POOL_SIZE_CLASSES = 8;
+
+struct PoolNode
+{
+	PoolNode* next;
+};
+
+struct EventPool
+{
+	PoolNode* freeLists[POOL_SIZE_CLASSES] = {nullptr};
+
+	~EventPool ()
+	{
+		for (PoolNode* node : freeLists)
+		{
+			while (node)
+			{
+				PoolNode* next = node->next;
+				::operator delete (node);
+				node = next;
+			}
+		}
+	}
+};
+
+thread_local EventPool eventPool;
+
+size_t getSizeClass (const size_t size) {return (size == 0 ? 0 : (size - 1) / POOL_GRANULARITY);}
+}
+
 Event::Event () : Event ((void*) nullptr, NO_EVENT) {}
 Event::Event (void* widget, const EventType type) : eventWidget (widget), eventType (type) {}
+Event::~Event () {}
+
+void* Event::operator new (size_t size)
+{
+	size_t sizeClass = getSizeClass (size);
+	if (sizeClass >= POOL_SIZE_CLASSES) return ::operator new (size);
+
+	PoolNode* node = eventPool.freeLists[sizeClass];
+	if (node)
+	{
+		eventPool.freeLists[sizeClass] = node->next;
+		return node;
+	}
+
+	return ::operator new ((sizeClass + 1) * POOL_GRANULARITY);
+}
+
+void Event::operator delete (void* ptr, size_t size)
+{
+	if (!ptr) return;
+
+	size_t sizeClass = getSizeClass (size);
+	if (sizeClass >= POOL_SIZE_CLASSES)
+	{
+		::operator delete (ptr);
+		return;
+	}
+
+	PoolNode* node = (PoolNode*) ptr;
+	node->next = eventPool.freeLists[sizeClass];
+	eventPool.freeLists[sizeClass] = node;
+}
+
 void* Event::getWidget () {return eventWidget;}
 EventType Event::getEventType () const {return eventType;}
 
@@ -66,7 +133,9 @@ void PointerEvent::setX (const double x) {xpos = x;}
 double PointerEvent::getX () const {return xpos;}
 void PointerEvent::setY (const double y) {ypos = y;}
 double PointerEvent::getY () const {return ypos;}
+void PointerEvent::setDeltaX (const double dx) {deltaX = dx;}
 double PointerEvent::getDeltaX () const {return deltaX;}
+void PointerEvent::setDeltaY (const double dy) {deltaY = dy;}
 double PointerEvent::getDeltaY () const {return deltaY;}
 void PointerEvent::setButton (const InputDevice button) {buttonNr = button;}
 InputDevice PointerEvent::getButton () const {return buttonNr;}
@@ -89,4 +158,46 @@ double ValueChangedEvent::getValue () const {return value;}
  * End of class BEvents::ValueChangedEvent
  *****************************************************************************/
 
+
+/*****************************************************************************
+ * Class BEvents::EventQueue
+ *****************************************************************************/
+
+EventQueue::EventQueue () : EventQueue (256) {}
+EventQueue::EventQueue (const size_t capacity) : ring (capacity > 0 ? capacity : 1, nullptr), head (0), count (0) {}
+
+void EventQueue::push (Event* event)
+{
+	// Full: double capacity and unwrap the queued events
+	if (count == ring.size ())
+	{
+		std::vector<Event*> newRing (2 * ring.size (), nullptr);
+		for (size_t i = 0; i < count; ++i) newRing[i] = ring[(head + i) % ring.size ()];
+		ring.swap (newRing);
+		head = 0;
+	}
+
+	ring[(head + count) % ring.size ()] = event;
+	++count;
+}
+
+Event* EventQueue::front () const {return (count > 0 ? ring[head] : nullptr);}
+
+void EventQueue::pop ()
+{
+	if (count == 0) return;
+
+	ring[head] = nullptr;
+	head = (head + 1) % ring.size ();
+	--count;
+}
+
+Event* EventQueue::at (const size_t n) const {return ring[(head + n) % ring.size ()];}
+size_t EventQueue::size () const {return count;}
+bool EventQueue::empty () const {return (count == 0);}
+
+/*
+ * End of class BEvents::EventQueue
+ *****************************************************************************/
+
 }
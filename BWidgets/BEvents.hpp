@@ -19,6 +19,8 @@
 #define BEVENTS_HPP_
 
 #include <stdint.h>
+#include <cstddef>
+#include <vector>
 
 namespace BEvents
 {
@@ -61,6 +63,24 @@ class Event
 public:
 	Event ();
 	Event (void* widget, const EventType type);
+	virtual ~Event ();
+
+	/**
+	 * Allocates memory for an event from the event pool. Released events are
+	 * kept in per-thread free lists (one for each size class) and are reused
+	 * by the next event of the same size class. Thus, there are no heap
+	 * allocations in steady state.
+	 * @param size Size of the event object
+	 * @return Pointer to the allocated memory
+	 */
+	static void* operator new (size_t size);
+
+	/**
+	 * Releases the memory of an event to the event pool.
+	 * @param ptr Pointer to the memory of the event
+	 * @param size Size of the event object
+	 */
+	static void operator delete (void* ptr, size_t size);
 
 	/**
 	 * Gets a pointer to the widget which caused the event.
@@ -198,8 +218,20 @@ public:
 	 */
 	double getY () const;
 
+	/**
+	 * Redefines the x distance of the pointer event
+	 * @param dx X distance moved since the previous pointer event
+	 */
+	void setDeltaX (const double dx);
+
 	double getDeltaX () const;
 
+	/**
+	 * Redefines the y distance of the pointer event
+	 * @param dy Y distance moved since the previous pointer event
+	 */
+	void setDeltaY (const double dy);
+
 	double getDeltaY () const;
 
 	/**
@@ -261,6 +293,69 @@ protected:
 /*
  * End of class BEvents::ValueChangedEvent
  *****************************************************************************/
+
+
+/**
+ * Class BEvents::EventQueue
+ *
+ * First-in-first-out queue of (pointers to) events based on a ring buffer.
+ * The capacity is only increased (doubled) if the queue is full. Thus, once
+ * the queue reached its working size, neither pushing nor popping events
+ * causes heap allocations or moves of the queued events.
+ */
+class EventQueue
+{
+public:
+	EventQueue ();
+	EventQueue (const size_t capacity);
+	EventQueue (const EventQueue& that) = delete;
+	EventQueue& operator= (const EventQueue& that) = delete;
+
+	/**
+	 * Appends an event to the end of the queue.
+	 * @param event Pointer to the event
+	 */
+	void push (Event* event);
+
+	/**
+	 * Gets the first (oldest) event of the queue.
+	 * @return Pointer to the event, nullptr if the queue is empty
+	 */
+	Event* front () const;
+
+	/**
+	 * Removes the first (oldest) event from the queue. The event itself
+	 * isn't deleted.
+	 */
+	void pop ();
+
+	/**
+	 * Gets the n-th event of the queue.
+	 * @param n Position within the queue (0 = first event)
+	 * @return Pointer to the event
+	 */
+	Event* at (const size_t n) const;
+
+	/**
+	 * Gets the number of events in the queue.
+	 * @return Number of events
+	 */
+	size_t size () const;
+
+	/**
+	 * Tests whether the queue is empty.
+	 * @return TRUE if empty, otherwise FALSE
+	 */
+	bool empty () const;
+
+protected:
+	std::vector<Event*> ring;
+	size_t head;
+	size_t count;
+};
+/*
+ * End of class BEvents::EventQueue
+ *****************************************************************************/
 }
 
 #endif /* BEVENTS_HPP_ */
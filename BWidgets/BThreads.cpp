@@ -0,0 +1,97 @@
+/* Copyright (C) 2018 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include "BThreads.hpp"
+
+namespace BThreads {
+
+ThreadPool::ThreadPool (const int nrThreads) :
+		threads_ (), job_ (), count_ (0), next_ (0), running_ (0), generation_ (0), quit_ (false)
+{
+	for (int i = 0; i < nrThreads; ++i) threads_.push_back (std::thread (&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool ()
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		quit_ = true;
+	}
+	startCondition_.notify_all ();
+
+	for (std::thread& t : threads_) t.join ();
+}
+
+int ThreadPool::getNrThreads () const {return threads_.size ();}
+
+void ThreadPool::run (const int count, const std::function<void (const int)>& job)
+{
+	if (count <= 0) return;
+
+	// No workers or a single job: Run in the calling thread
+	if (threads_.empty () || (count == 1))
+	{
+		for (int i = 0; i < count; ++i) job (i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		job_ = job;
+		count_ = count;
+		next_ = 0;
+		running_ = threads_.size ();
+		++generation_;
+	}
+	startCondition_.notify_all ();
+
+	// Take part in processing and wait for the workers
+	process ();
+	std::unique_lock<std::mutex> lock (mutex_);
+	doneCondition_.wait (lock, [this] () {return (running_ == 0);});
+	job_ = nullptr;
+}
+
+void ThreadPool::work ()
+{
+	uint64_t generation = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock (mutex_);
+			startCondition_.wait (lock, [this, generation] () {return (quit_ || (generation_ != generation));});
+			if (quit_) return;
+			generation = generation_;
+		}
+
+		process ();
+
+		{
+			std::lock_guard<std::mutex> lock (mutex_);
+			--running_;
+			if (running_ == 0) doneCondition_.notify_all ();
+		}
+	}
+}
+
+void ThreadPool::process ()
+{
+	for (int i = next_++; i < count_; i = next_++) job_ (i);
+}
+
+}
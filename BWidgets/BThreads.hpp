@@ -0,0 +1,88 @@
+/* Copyright (C) 2018 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BTHREADS_HPP_
+#define BTHREADS_HPP_
+
+#include <stdint.h>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace BThreads {
+
+/**
+ * Class BThreads::ThreadPool
+ *
+ * Small pool of worker threads to run independent jobs (e.g., drawing of
+ * widgets into their own surfaces) in parallel.
+ */
+class ThreadPool
+{
+public:
+	/**
+	 * Creates a thread pool and starts its worker threads.
+	 * @param nrThreads Number of worker threads
+	 */
+	ThreadPool (const int nrThreads);
+
+	ThreadPool (const ThreadPool& that) = delete;
+
+	/**
+	 * Stops and joins all worker threads.
+	 */
+	~ThreadPool ();
+
+	ThreadPool& operator= (const ThreadPool& that) = delete;
+
+	/**
+	 * Gets the number of worker threads.
+	 * @return Number of worker threads
+	 */
+	int getNrThreads () const;
+
+	/**
+	 * Runs a job for each index 0 .. count - 1. The indices are distributed
+	 * to the worker threads and the calling thread. Blocks until all jobs
+	 * are done.
+	 * @param count Number of jobs
+	 * @param job Function to be called with the job index
+	 */
+	void run (const int count, const std::function<void (const int)>& job);
+
+protected:
+	void work ();
+	void process ();
+
+	std::vector<std::thread> threads_;
+	std::mutex mutex_;
+	std::condition_variable startCondition_;
+	std::condition_variable doneCondition_;
+	std::function<void (const int)> job_;
+	int count_;
+	std::atomic<int> next_;
+	int running_;
+	uint64_t generation_;
+	bool quit_;
+};
+
+}
+
+#endif /* BTHREADS_HPP_ */
@@ -2,17 +2,22 @@
 
 namespace BWidgets
 {
+// IDs of the cached patterns
+enum {BUTTON_PATTERN};
+
 Button::Button () : Button (0.0, 0.0, 50.0, 50.0, "button", 0.0) {}
 
 Button::Button (const double x, const double y, const double width, const double height, const std::string& name, const double defaultValue) :
-		ValueWidget (x, y, width, height, name, defaultValue), buttonColors (BColors::greys), bgColors (BColors::greys)
+		ValueWidget (x, y, width, height, name, defaultValue), buttonColors (BColors::greys), bgColors (BColors::greys),
+		stateSurfaces {nullptr, nullptr}
 {
 	setClickable (true);
 }
 
-Button::Button (const Button& that) : ValueWidget (that), buttonColors (that.buttonColors), bgColors (that.buttonColors) {}
+Button::Button (const Button& that) :
+		ValueWidget (that), buttonColors (that.buttonColors), bgColors (that.buttonColors), stateSurfaces {nullptr, nullptr} {}
 
-Button:: ~Button () {}
+Button:: ~Button () {invalidateStateSurfaces ();}
 
 Button& Button::operator= (const Button& that)
 {
@@ -32,7 +37,8 @@ BColors::ColorSet* Button::getButtonColors () {return &buttonColors;}
 
 void Button::update ()
 {
-	draw (0, 0, width_, height_);
+	invalidateStateSurfaces ();
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
@@ -55,34 +61,98 @@ void Button::onButtonPressed (BEvents::PointerEvent* event) {setValue (1.0);}
 
 void Button::onButtonReleased (BEvents::PointerEvent* event) {setValue (0.0);}
 
+void Button::updateValue (const double oldValue)
+{
+	// Keep the state surfaces, only swap them if the state changed
+	if ((value != 0.0) != (oldValue != 0.0))
+	{
+		markDirty ();
+		if (isVisible ()) postRedisplay ();
+	}
+}
+
+cairo_surface_t* Button::getStateSurface (const int state)
+{
+	// Invalidate on resize
+	for (cairo_surface_t* s : stateSurfaces)
+	{
+		if (s &&
+			((cairo_image_surface_get_width (s) != cairo_image_surface_get_width (widgetSurface)) ||
+			 (cairo_image_surface_get_height (s) != cairo_image_surface_get_height (widgetSurface))))
+		{
+			invalidateStateSurfaces ();
+			break;
+		}
+	}
+
+	if (!stateSurfaces[state])
+	{
+		stateSurfaces[state] = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
+		drawState (stateSurfaces[state], state);
+	}
+
+	return stateSurfaces[state];
+}
+
+void Button::invalidateStateSurfaces ()
+{
+	for (cairo_surface_t*& s : stateSurfaces)
+	{
+		if (s)
+		{
+			cairo_surface_destroy (s);
+			s = nullptr;
+		}
+	}
+}
+
 void Button::draw (const double x, const double y, const double width, const double height)
 {
-	if ((width_ >= 6) && (height_ >= 6))
+	cairo_surface_t* surface = getStateSurface (value != 0.0 ? 1 : 0);
+	cairo_t* cr = cairo_create (widgetSurface);
+
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 	{
-		// Draw super class widget elements first
-		Widget::draw (x, y, width, height);
+		// Limit cairo-drawing area and copy the state surface
+		cairo_rectangle (cr, x, y, width, height);
+		cairo_clip (cr);
+		cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+		cairo_set_source_surface (cr, surface, 0, 0);
+		cairo_paint (cr);
+	}
+
+	cairo_destroy (cr);
+}
+
+void Button::drawState (cairo_surface_t* surface, const int state)
+{
+	// Draw super class widget elements first
+	drawWidgetElements (surface, 0, 0, width_, height_);
 
-		cairo_t* cr = cairo_create (widgetSurface);
+	if ((width_ >= 6) && (height_ >= 6))
+	{
+		cairo_t* cr = cairo_create (surface);
 		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 		{
 			cairo_pattern_t* pat;
 
-			// Limit cairo-drawing area
-			cairo_rectangle (cr, x, y, width, height);
-			cairo_clip (cr);
-
 			BColors::Color butColorLo = *buttonColors.getColor (BColors::NORMAL);
 			BColors::Color butColorHi = *buttonColors.getColor (BColors::ACTIVE);
 			BColors::Color bgColorHi = *bgColors.getColor (BColors::INACTIVE);
 			BColors::Color bgColorLo = *bgColors.getColor (BColors::OFF);
 
-			pat = cairo_pattern_create_linear (0, 0 , width_, height_);
-			cairo_pattern_add_color_stop_rgba (pat, 0.0, butColorHi.getRed (), butColorHi.getGreen (), butColorHi.getBlue (), butColorHi.getAlpha ());
-			cairo_pattern_add_color_stop_rgba (pat, 1, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getBlue (), butColorLo.getAlpha ());
+			pat = getCachedPattern (BUTTON_PATTERN, {width_, height_}, {butColorHi, butColorLo});
+			if (!pat)
+			{
+				pat = cairo_pattern_create_linear (0, 0 , width_, height_);
+				cairo_pattern_add_color_stop_rgba (pat, 0.0, butColorHi.getRed (), butColorHi.getGreen (), butColorHi.getBlue (), butColorHi.getAlpha ());
+				cairo_pattern_add_color_stop_rgba (pat, 1, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getBlue (), butColorLo.getAlpha ());
+				setCachedPattern (BUTTON_PATTERN, {width_, height_}, {butColorHi, butColorLo}, pat);
+			}
 
 			cairo_set_line_width (cr, 0.5);
 
-			if (value)
+			if (state)
 			{
 				cairo_rectangle (cr, 2.5, 2.5, width_ - 3, height_ - 3);
 				cairo_set_source (cr, pat);
@@ -125,8 +195,6 @@ void Button::draw (const double x, const double y, const double width, const dou
 				cairo_stroke (cr);
 
 			}
-
-			cairo_pattern_destroy (pat);
 		}
 		cairo_destroy (cr);
 	}
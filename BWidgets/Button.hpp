@@ -48,8 +48,8 @@ public:
 	BColors::ColorSet* getButtonColors ();
 
 	/**
-	 * Calls a redraw of the widget and calls postRedisplay () if the the
-	 * Widget is visible.
+	 * Invalidates the cached state surfaces, calls a redraw of the widget and
+	 * calls postRedisplay () if the the Widget is visible.
 	 * This method should be called if the widgets properties are indirectly
 	 * changed.
 	 */
@@ -79,10 +79,42 @@ public:
 	virtual void onButtonReleased (BEvents::PointerEvent* event) override;
 
 protected:
+	/**
+	 * Redraws the widget only if the state (on / off) changed. The cached
+	 * state surfaces are kept.
+	 * @param oldValue Value before the change
+	 */
+	virtual void updateValue (const double oldValue) override;
+
+	/**
+	 * Gets the cached surface of a button state. The surface is (re-)drawn
+	 * via drawState if it was invalidated or if the widget size changed.
+	 * @param state 0 (off) or 1 (on)
+	 * @return Pointer to the state surface
+	 */
+	cairo_surface_t* getStateSurface (const int state);
+
+	/**
+	 * Invalidates the cached state surfaces (e.g., if the widget properties
+	 * changed).
+	 */
+	void invalidateStateSurfaces ();
+
+	/**
+	 * Draws the whole widget for a button state.
+	 * @param surface State surface of the widget size
+	 * @param state 0 (off) or 1 (on)
+	 */
+	virtual void drawState (cairo_surface_t* surface, const int state);
+
+	/**
+	 * Copies the area from the surface of the actual button state.
+	 */
 	virtual void draw (const double x, const double y, const double width, const double height) override;
 
 	BColors::ColorSet buttonColors;
 	BColors::ColorSet bgColors;
+	cairo_surface_t* stateSurfaces[2];
 };
 
 }
@@ -6,6 +6,9 @@
 
 namespace BWidgets
 {
+// IDs of the cached patterns
+enum {INNER_FILL_PATTERN, INNER_STROKE_PATTERN, ARC_PATTERN};
+
 Dial::Dial () : Dial (0.0, 0.0, 50.0, 50.0, "dial", 0.0, 0.0, 100.0, 1.0) {}
 
 Dial::Dial (const double x, const double y, const double width, const double height, const std::string& name,
@@ -29,12 +32,6 @@ Dial& Dial::operator= (const Dial& that)
 	return *this;
 }
 
-void Dial::update ()
-{
-	draw (0, 0, width_, height_);
-	if (isVisible ()) postRedisplay ();
-}
-
 void Dial::applyTheme (BStyles::Theme& theme) {applyTheme (theme, name_);}
 
 void Dial::applyTheme (BStyles::Theme& theme, const std::string& name)
@@ -84,38 +81,41 @@ void Dial::onButtonPressed (BEvents::PointerEvent* event)
 
 void Dial::onPointerMotionWhileButtonPressed (BEvents::PointerEvent* event) {onButtonPressed (event);}
 
-void Dial::draw (const double x, const double y, const double width, const double height)
+void Dial::updateDisplayedValue (const double oldValue)
+{
+	// Keep the static layer, only the value-dependent parts change
+	markDirty ();
+	if (isVisible ()) postRedisplay ();
+}
+
+int Dial::getDisplayPositions () const
+{
+	if ((height_ < 12) || (width_ < 12)) return 0;
+
+	// Length of the outer arc (1.4 PI)
+	double size = (height_ < width_ ? height_ : width_);
+	return ceil (1.4 * PI * 0.48 * size);
+}
+
+void Dial::drawStaticLayer (cairo_surface_t* surface)
 {
+	// Draw super class widget elements first
+	RangeWidget::drawStaticLayer (surface);
 
-	// Draw dial
+	// Draw value-independent parts of the dial
 	// only if minimum requirements satisfied
 	if ((height_ >= 12) && (width_ >= 12))
 	{
 		double size = (height_ < width_ ? height_ : width_);
 
-		// Draw super class widget elements first
-		Widget::draw (x, y, width, height);
-
-		cairo_t* cr = cairo_create (widgetSurface);
+		cairo_t* cr = cairo_create (surface);
 
 		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 		{
 			cairo_pattern_t* pat;
 
-			// Limit cairo-drawing area
-			cairo_rectangle (cr, x, y, width, height);
-			cairo_clip (cr);
-
-			// Relative Value (0 .. 1) for calculation of value line
-			double relVal;
-			if (getMax () != getMin ()) relVal = (getValue () - getMin ()) / (getMax () - getMin ());
-			else relVal = 0.5;							// min == max doesn't make any sense, but need to be handled
-			if (getStep() < 0) relVal = 1 - relVal;		// Swap if reverse orientation
-
 			// Colors uses within this method
 			BColors::Color fgInact = *fgColors.getColor (BColors::INACTIVE);
-			BColors::Color fgActive = *fgColors.getColor (BColors::ACTIVE);
-			BColors::Color fgNormal = *fgColors.getColor (BColors::NORMAL);
 			BColors::Color bgNormal = *bgColors.getColor (BColors::NORMAL);
 			BColors::Color bgActive = *bgColors.getColor (BColors::ACTIVE);
 			BColors::Color bgInact = *bgColors.getColor (BColors::INACTIVE);
@@ -131,59 +131,87 @@ void Dial::draw (const double x, const double y, const double width, const doubl
 			cairo_set_source_rgba (cr, bgInact.getRed (), bgInact.getGreen (), bgInact.getBlue (), bgInact.getAlpha ());
 			cairo_stroke (cr);
 
-			// Filled part (= active) of outer arc
-			pat = cairo_pattern_create_linear (0.5 * width_ - 0.5 * size, 0.5 * height - 0.5 * size,
-											   0.5 * width_ + 0.5 * size, 0.5 * height + 0.5 * size);
-			cairo_pattern_add_color_stop_rgba (pat, 0.0, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
-			cairo_pattern_add_color_stop_rgba (pat, 0.25, fgActive.getRed (), fgActive.getGreen (), fgActive.getBlue (), fgActive.getAlpha ());
-			cairo_pattern_add_color_stop_rgba (pat, 1, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
-			if (getStep () >= 0)
-			{
-				cairo_arc (cr, 0.5 * width_, 0.5 * height_,  0.48 * size, PI * 0.8, PI * (0.8 + 1.4 * relVal));
-				cairo_arc_negative (cr, 0.5 * width_, 0.5 * height_, 0.35 * size, PI * (0.8 + 1.4 * relVal), PI * 0.8);
-			}
-			else
-			{
-				cairo_arc (cr, 0.5 * width_, 0.5 * height_,  0.48 * size, PI * (0.8 + 1.4 * relVal), PI * 2.2);
-				cairo_arc_negative (cr, 0.5 * width_, 0.5 * height_, 0.35 * size, PI * 2.2, PI * (0.8 + 1.4 * relVal));
-			}
-			cairo_close_path (cr);
-			cairo_set_source (cr, pat);
-			cairo_fill (cr);
-
 			// Inner circle
 			cairo_arc (cr, 0.5 * width_, 0.5 * height_, 0.3 * size, 0, 2 * PI);
 			cairo_close_path (cr);
 
 
-			pat = cairo_pattern_create_radial (0.5 * width_ - 0.25 * size, 0.5 * height_ - 0.25 * size, 0.1 * size,
-											   0.5 * width_, 0.5 * height_, 1.5 * size);
-			cairo_pattern_add_color_stop_rgba (pat, 0, bgActive.getRed (), bgActive.getGreen (), bgActive.getBlue (), bgActive.getAlpha ());
-			cairo_pattern_add_color_stop_rgba (pat, 1, bgNormal.getRed (), bgNormal.getGreen (), bgNormal.getBlue (), bgNormal.getAlpha ());
+			pat = getCachedPattern (INNER_FILL_PATTERN, {width_, height_}, {bgActive, bgNormal});
+			if (!pat)
+			{
+				pat = cairo_pattern_create_radial (0.5 * width_ - 0.25 * size, 0.5 * height_ - 0.25 * size, 0.1 * size,
+												   0.5 * width_, 0.5 * height_, 1.5 * size);
+				cairo_pattern_add_color_stop_rgba (pat, 0, bgActive.getRed (), bgActive.getGreen (), bgActive.getBlue (), bgActive.getAlpha ());
+				cairo_pattern_add_color_stop_rgba (pat, 1, bgNormal.getRed (), bgNormal.getGreen (), bgNormal.getBlue (), bgNormal.getAlpha ());
+				setCachedPattern (INNER_FILL_PATTERN, {width_, height_}, {bgActive, bgNormal}, pat);
+			}
 			cairo_set_source (cr, pat);
 			cairo_fill_preserve (cr);
-			cairo_pattern_destroy (pat);
 
-			pat = cairo_pattern_create_radial (0.5 * width_ - 0.25 * size, 0.5 * height_ - 0.25 * size, 0.1 * size,
-											   0.5 * width_, 0.5 * height_, 1.5 * size);
-			cairo_pattern_add_color_stop_rgba (pat, 0, bgInact.getRed (), bgInact.getGreen (), bgInact.getBlue (), bgInact.getAlpha ());
-			cairo_pattern_add_color_stop_rgba (pat, 1, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), bgOff.getAlpha ());
+			pat = getCachedPattern (INNER_STROKE_PATTERN, {width_, height_}, {bgInact, bgOff});
+			if (!pat)
+			{
+				pat = cairo_pattern_create_radial (0.5 * width_ - 0.25 * size, 0.5 * height_ - 0.25 * size, 0.1 * size,
+												   0.5 * width_, 0.5 * height_, 1.5 * size);
+				cairo_pattern_add_color_stop_rgba (pat, 0, bgInact.getRed (), bgInact.getGreen (), bgInact.getBlue (), bgInact.getAlpha ());
+				cairo_pattern_add_color_stop_rgba (pat, 1, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), bgOff.getAlpha ());
+				setCachedPattern (INNER_STROKE_PATTERN, {width_, height_}, {bgInact, bgOff}, pat);
+			}
 			cairo_set_line_width (cr, 0.5);
 			cairo_set_source (cr, pat);
 			cairo_stroke (cr);
-			cairo_pattern_destroy (pat);
-
-			// Dot
-			cairo_set_source_rgba (cr, fgActive.getRed (), fgActive.getGreen (), fgActive.getBlue (), fgActive.getAlpha ());
-			cairo_arc (cr, 0.5 * width_ + 0.20 * size * cos (PI * (0.8 + 1.4 *relVal)),
-					   0.5 * height_ + 0.20 * size * sin (PI * (0.8 + 1.4 *relVal)),
-					   0.05 * size, 0, PI * 2);
-			cairo_close_path (cr);
-			cairo_fill (cr);
 		}
 
 		cairo_destroy (cr);
 	}
 }
 
+void Dial::drawDynamicLayer (cairo_t* cr, const double relVal)
+{
+	// Draw value-dependent parts of the dial (active arc and dot)
+	// only if minimum requirements satisfied
+	if ((height_ >= 12) && (width_ >= 12))
+	{
+		double size = (height_ < width_ ? height_ : width_);
+		cairo_pattern_t* pat;
+
+		// Colors uses within this method
+		BColors::Color fgActive = *fgColors.getColor (BColors::ACTIVE);
+		BColors::Color fgNormal = *fgColors.getColor (BColors::NORMAL);
+
+		// Filled part (= active) of outer arc
+		pat = getCachedPattern (ARC_PATTERN, {width_, height_}, {fgNormal, fgActive});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_linear (0.5 * width_ - 0.5 * size, 0.5 * height_ - 0.5 * size,
+											   0.5 * width_ + 0.5 * size, 0.5 * height_ + 0.5 * size);
+			cairo_pattern_add_color_stop_rgba (pat, 0.0, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
+			cairo_pattern_add_color_stop_rgba (pat, 0.25, fgActive.getRed (), fgActive.getGreen (), fgActive.getBlue (), fgActive.getAlpha ());
+			cairo_pattern_add_color_stop_rgba (pat, 1, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
+			setCachedPattern (ARC_PATTERN, {width_, height_}, {fgNormal, fgActive}, pat);
+		}
+		if (getStep () >= 0)
+		{
+			cairo_arc (cr, 0.5 * width_, 0.5 * height_,  0.48 * size, PI * 0.8, PI * (0.8 + 1.4 * relVal));
+			cairo_arc_negative (cr, 0.5 * width_, 0.5 * height_, 0.35 * size, PI * (0.8 + 1.4 * relVal), PI * 0.8);
+		}
+		else
+		{
+			cairo_arc (cr, 0.5 * width_, 0.5 * height_,  0.48 * size, PI * (0.8 + 1.4 * relVal), PI * 2.2);
+			cairo_arc_negative (cr, 0.5 * width_, 0.5 * height_, 0.35 * size, PI * 2.2, PI * (0.8 + 1.4 * relVal));
+		}
+		cairo_close_path (cr);
+		cairo_set_source (cr, pat);
+		cairo_fill (cr);
+
+		// Dot
+		cairo_set_source_rgba (cr, fgActive.getRed (), fgActive.getGreen (), fgActive.getBlue (), fgActive.getAlpha ());
+		cairo_arc (cr, 0.5 * width_ + 0.20 * size * cos (PI * (0.8 + 1.4 *relVal)),
+				   0.5 * height_ + 0.20 * size * sin (PI * (0.8 + 1.4 *relVal)),
+				   0.05 * size, 0, PI * 2);
+		cairo_close_path (cr);
+		cairo_fill (cr);
+	}
+}
+
 }
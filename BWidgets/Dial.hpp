@@ -35,14 +35,6 @@ public:
 	 */
 	Dial& operator= (const Dial& that);
 
-	/**
-	 * Calls a redraw of the widget and calls postRedisplay () if the the
-	 * Widget is visible.
-	 * This method should be called if the widgets properties are indirectly
-	 * changed.
-	 */
-	virtual void update () override;
-
 	/**
 	 * Scans theme for widget properties and applies these properties.
 	 * @param theme Theme to be scanned.
@@ -70,7 +62,21 @@ public:
 
 
 protected:
-	virtual void draw (const double x, const double y, const double width, const double height) override;
+	/**
+	 * Updates the dial after a change of the displayed value. Only the
+	 * value-dependent parts (active arc, dot) are redrawn on top of the
+	 * static layer.
+	 * @param oldValue Value before the change
+	 */
+	virtual void updateDisplayedValue (const double oldValue) override;
+
+	/**
+	 * Gets the number of pixel steps along the outer arc.
+	 */
+	virtual int getDisplayPositions () const override;
+
+	virtual void drawStaticLayer (cairo_surface_t* surface) override;
+	virtual void drawDynamicLayer (cairo_t* cr, const double relVal) override;
 
 	BColors::ColorSet fgColors;
 	BColors::ColorSet bgColors;
@@ -85,7 +85,7 @@ Label* DialWithValueDisplay::getValueDisplay () {return &valueDisplay;}
 void DialWithValueDisplay::update ()
 {
 	updateChildCoords ();
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
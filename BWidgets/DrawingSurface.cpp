@@ -8,7 +8,7 @@ DrawingSurface::DrawingSurface (const double x, const double y, const double wid
 		Widget (x, y, width, height, name)
 {
 	drawingSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, getEffectiveWidth (), getEffectiveHeight ());
-	draw (0, 0, width_, height_);
+	markDirty ();
 }
 
 DrawingSurface::DrawingSurface (const DrawingSurface& that) :
@@ -16,7 +16,7 @@ DrawingSurface::DrawingSurface (const DrawingSurface& that) :
 {
 	drawingSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, getEffectiveWidth (), getEffectiveHeight ());
 	//TODO copy surface data
-	draw (0, 0, width_, height_);
+	markDirty ();
 }
 
 DrawingSurface::~DrawingSurface ()
@@ -83,17 +83,17 @@ void DrawingSurface::setBorder (const BStyles::Border& border)
 
 void DrawingSurface::update ()
 {
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
 void DrawingSurface::draw (const double x, const double y, const double width, const double height)
 {
+	// Draw super class widget elements first
+	Widget::draw (x, y, width, height);
+
 	if ((width_ >= 4) && (height_ >= 4))
 	{
-		// Draw super class widget elements first
-		Widget::draw (x, y, width, height);
-
 		cairo_t* cr = cairo_create (widgetSurface);
 		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 		{
@@ -6,6 +6,9 @@
 
 namespace BWidgets
 {
+// IDs of the cached patterns
+enum {SCALE_PATTERN, KNOB_FILL_PATTERN, KNOB_STROKE_PATTERN};
+
 HSlider::HSlider () : HSlider (0, 0, 12, 100, "hslider", 0.0, 0.0, 100.0, 0.0) {}
 
 HSlider::HSlider (const double  x, const double y, const double width, const double height, const std::string& name,
@@ -29,12 +32,6 @@ HSlider& HSlider::operator= (const HSlider& that)
 	return *this;
 }
 
-void HSlider::update ()
-{
-	draw (0, 0, width_, height_);
-	if (isVisible ()) postRedisplay ();
-}
-
 void HSlider::applyTheme (BStyles::Theme& theme) {applyTheme (theme, name_);}
 
 void HSlider::applyTheme (BStyles::Theme& theme, const std::string& name)
@@ -81,49 +78,62 @@ void HSlider::onButtonPressed (BEvents::PointerEvent* event)
 
 void HSlider::onPointerMotionWhileButtonPressed (BEvents::PointerEvent* event) {onButtonPressed (event);}
 
-void HSlider::draw (const double x, const double y, const double width, const double height)
+void HSlider::updateDisplayedValue (const double oldValue)
+{
+	if ((height_ >= 4) && (width_ >= 4))
+	{
+		// Same geometry as in draw
+		double h = (height_ > 24.0 ? 12.0 : 0.5 * height_);
+		double w = (width_ / height_ >= 2 ? width_ - 2 * h : width_ - (width_ / height_) * h);
+		double xOld = width_ / 2 - w / 2 + getDisplayedRelativeValue (oldValue) * (w - 2) + 1;
+		double xNew = width_ / 2 - w / 2 + getDisplayedRelativeValue (getValue ()) * (w - 2) + 1;
+
+		// Knob (radius h - 1, line width 0.5) and scale in between
+		double x0 = (xOld < xNew ? xOld : xNew) - h - 1;
+		double x1 = (xOld > xNew ? xOld : xNew) + h + 1;
+		updateArea (x0, 0, x1 - x0, height_);
+	}
+
+	else update ();
+}
+
+int HSlider::getDisplayPositions () const
+{
+	if ((height_ < 4) || (width_ < 4)) return 0;
+
+	// Travel of the value line (w - 2, see drawDynamicLayer)
+	double h = (height_ > 24.0 ? 12.0 : 0.5 * height_);
+	double w = (width_ / height_ >= 2 ? width_ - 2 * h : width_ - (width_ / height_) * h);
+	return (w > 2 ? ceil (w - 2) : 0);
+}
+
+bool HSlider::isOpaque () {return false;}
+
+void HSlider::drawStaticLayer (cairo_surface_t* surface)
 {
 	// Draw super class widget elements first
-	Widget::draw (x, y, width, height);
+	RangeWidget::drawStaticLayer (surface);
 
-	// Draw slider
+	// Draw value-independent parts of the slider (frame and scale background)
 	// only if minimum requirements satisfied
 	if ((height_ >= 4) && (width_ >= 4))
 	{
-		cairo_surface_clear (widgetSurface);
-		cairo_t* cr = cairo_create (widgetSurface);
+		cairo_surface_clear (surface);
+		cairo_t* cr = cairo_create (surface);
 
 		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 		{
-			cairo_pattern_t* pat;
-
-			// Limit cairo-drawing area
-			cairo_rectangle (cr, x, y, width, height);
-			cairo_clip (cr);
-
 			// Calculate aspect ratios first
 			double h = (height_ > 24.0 ? 12.0 : 0.5 * height_);
 			double w = (width_ / height_ >= 2 ? width_ - 2 * h : width_ - (width_ / height_) * h);
 
-			// Relative Value (0 .. 1) for calculation of value line
-			double relVal;
-			if (getMax () != getMin ()) relVal = (getValue () - getMin ()) / (getMax () - getMin ());
-			else relVal = 0.5;							// min == max doesn't make any sense, but need to be handled
-			if (getStep() < 0) relVal = 1 - relVal;		// Swap if reverse orientation
-
-			double x1 = width_ / 2 - w / 2; double y1 = height_ / 2 - h / 2;								// Top left
-			double x2 = width_ / 2 - w / 2 + relVal * (w - 2) + 1; double y2 = height_ / 2 + h / 2 - 1; 	// Value line bottom
-			double x3 = x2; double y3 = y1;																	// Value line top
-			double x4 = width_ / 2 + w / 2 - 1; double y4 = y2; 											// Bottom right
+			double x1 = width_ / 2 - w / 2; double y1 = height_ / 2 - h / 2;				// Top left
+			double x4 = width_ / 2 + w / 2 - 1; double y4 = height_ / 2 + h / 2 - 1; 	// Bottom right
 
 			if (getStep () >= 0) std::swap (x1, x4); // Swap left <-> right if reverse orientation
 
 			// Colors uses within this method
 			BColors::Color fgInact = *fgColors.getColor (BColors::INACTIVE);
-			BColors::Color fgActive = *fgColors.getColor (BColors::ACTIVE);
-			BColors::Color fgNormal = *fgColors.getColor (BColors::NORMAL);
-			BColors::Color bgNormal = *bgColors.getColor (BColors::NORMAL);
-			BColors::Color bgActive = *bgColors.getColor (BColors::ACTIVE);
 			BColors::Color bgInact = *bgColors.getColor (BColors::INACTIVE);
 			BColors::Color bgOff = *bgColors.getColor (BColors::OFF);
 
@@ -140,49 +150,93 @@ void HSlider::draw (const double x, const double y, const double width, const do
 			cairo_fill_preserve (cr);
 			cairo_set_source_rgba (cr, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), bgOff.getAlpha ());
 			cairo_stroke (cr);
+		}
+
+		cairo_destroy (cr);
+	}
+}
 
-			// Scale active
-			pat = cairo_pattern_create_linear (x3, y3, x2, y2);
+void HSlider::drawDynamicLayer (cairo_t* cr, const double relVal)
+{
+	// Draw value-dependent parts of the slider (active scale, shadow and knob)
+	// only if minimum requirements satisfied
+	if ((height_ >= 4) && (width_ >= 4))
+	{
+		cairo_pattern_t* pat;
+
+		// Calculate aspect ratios first
+		double h = (height_ > 24.0 ? 12.0 : 0.5 * height_);
+		double w = (width_ / height_ >= 2 ? width_ - 2 * h : width_ - (width_ / height_) * h);
+
+		double x1 = width_ / 2 - w / 2; double y1 = height_ / 2 - h / 2;								// Top left
+		double x2 = width_ / 2 - w / 2 + relVal * (w - 2) + 1; double y2 = height_ / 2 + h / 2 - 1; 	// Value line bottom
+		double x3 = x2; double y3 = y1;																	// Value line top
+		double x4 = width_ / 2 + w / 2 - 1; double y4 = y2; 											// Bottom right
+
+		if (getStep () >= 0) std::swap (x1, x4); // Swap left <-> right if reverse orientation
+
+		// Colors uses within this method
+		BColors::Color fgActive = *fgColors.getColor (BColors::ACTIVE);
+		BColors::Color fgNormal = *fgColors.getColor (BColors::NORMAL);
+		BColors::Color bgNormal = *bgColors.getColor (BColors::NORMAL);
+		BColors::Color bgActive = *bgColors.getColor (BColors::ACTIVE);
+		BColors::Color bgInact = *bgColors.getColor (BColors::INACTIVE);
+		BColors::Color bgOff = *bgColors.getColor (BColors::OFF);
+
+		// Scale active (gradient across the scale, independent from value)
+		pat = getCachedPattern (SCALE_PATTERN, {width_, height_}, {fgNormal, fgActive});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_linear (0, y3, 0, y2);
 			cairo_pattern_add_color_stop_rgba (pat, 0.0, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 0.25, fgActive.getRed (), fgActive.getGreen (), fgActive.getBlue (), fgActive.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 1, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
-			cairo_rectangle (cr, x3, y3, x4 - x3, y4 - y3);
-			cairo_set_source (cr, pat);
-			cairo_fill_preserve (cr);
-			cairo_stroke (cr);
-			cairo_pattern_destroy (pat);
-
-			//Shadow
-			cairo_move_to (cr, (x1 < x4 ? x1 : x4), y4);
-			cairo_line_to (cr, (x1 < x4 ? x1 : x4), y1);
-			cairo_line_to (cr, (x4 > x1 ? x4 : x1), y1);
-			cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
-			cairo_set_line_width (cr, 1.0);
-			cairo_set_source_rgba (cr, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), 0.5 * bgOff.getAlpha ());
-			cairo_stroke (cr);
-
-
-			// Knob
-			pat = cairo_pattern_create_radial ((x2 + x3) / 2 - h / 4, (y2 + y3) / 2 - h / 4, 0.1 * h,
-											   (x2 + x3) / 2, (y2 + y3) / 2, 1.5 * h);
-			cairo_arc (cr, (x2 + x3) / 2, (y2 + y3) / 2, h - 1, 0, 2 * PI);
+			setCachedPattern (SCALE_PATTERN, {width_, height_}, {fgNormal, fgActive}, pat);
+		}
+		cairo_rectangle (cr, x3, y3, x4 - x3, y4 - y3);
+		cairo_set_source (cr, pat);
+		cairo_fill_preserve (cr);
+		cairo_stroke (cr);
+
+		//Shadow
+		cairo_move_to (cr, (x1 < x4 ? x1 : x4), y4);
+		cairo_line_to (cr, (x1 < x4 ? x1 : x4), y1);
+		cairo_line_to (cr, (x4 > x1 ? x4 : x1), y1);
+		cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
+		cairo_set_line_width (cr, 1.0);
+		cairo_set_source_rgba (cr, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), 0.5 * bgOff.getAlpha ());
+		cairo_stroke (cr);
+
+
+		// Knob (patterns relative to the knob center, moved by the pattern matrix)
+		cairo_matrix_t matrix;
+		cairo_matrix_init_translate (&matrix, -(x2 + x3) / 2, -(y2 + y3) / 2);
+
+		pat = getCachedPattern (KNOB_FILL_PATTERN, {h}, {bgActive, bgNormal});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_radial (-h / 4, -h / 4, 0.1 * h, 0, 0, 1.5 * h);
 			cairo_pattern_add_color_stop_rgba (pat, 0, bgActive.getRed (), bgActive.getGreen (), bgActive.getBlue (), bgActive.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 1, bgNormal.getRed (), bgNormal.getGreen (), bgNormal.getBlue (), bgNormal.getAlpha ());
-			cairo_set_source (cr, pat);
-			cairo_fill_preserve (cr);
-			cairo_pattern_destroy (pat);
+			setCachedPattern (KNOB_FILL_PATTERN, {h}, {bgActive, bgNormal}, pat);
+		}
+		cairo_pattern_set_matrix (pat, &matrix);
+		cairo_arc (cr, (x2 + x3) / 2, (y2 + y3) / 2, h - 1, 0, 2 * PI);
+		cairo_set_source (cr, pat);
+		cairo_fill_preserve (cr);
 
-			pat = cairo_pattern_create_radial ( (x2 + x3) / 2 - h / 4, (y2 + y3) / 2 - h / 4, 0.1 * h,
-											    (x2 + x3) / 2, (y2 + y3) / 2, 1.2 * h);
+		pat = getCachedPattern (KNOB_STROKE_PATTERN, {h}, {bgInact, bgOff});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_radial (-h / 4, -h / 4, 0.1 * h, 0, 0, 1.2 * h);
 			cairo_pattern_add_color_stop_rgba (pat, 0, bgInact.getRed (), bgInact.getGreen (), bgInact.getBlue (), bgInact.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 1, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), bgOff.getAlpha ());
-			cairo_set_line_width (cr, 0.5);
-			cairo_set_source (cr, pat);
-			cairo_stroke (cr);
-			cairo_pattern_destroy (pat);
+			setCachedPattern (KNOB_STROKE_PATTERN, {h}, {bgInact, bgOff}, pat);
 		}
-
-		cairo_destroy (cr);
+		cairo_pattern_set_matrix (pat, &matrix);
+		cairo_set_line_width (cr, 0.5);
+		cairo_set_source (cr, pat);
+		cairo_stroke (cr);
 	}
 }
 
@@ -35,14 +35,6 @@ public:
 	 */
 	HSlider& operator= (const HSlider& that);
 
-	/**
-	 * Calls a redraw of the widget and calls postRedisplay () if the the
-	 * Widget is visible.
-	 * This method should be called if the widgets properties are indirectly
-	 * changed.
-	 */
-	virtual void update ();
-
 	/**
 	 * Scans theme for widget properties and applies these properties.
 	 * @param theme Theme to be scanned.
@@ -68,8 +60,27 @@ public:
 	 */
 	virtual void onPointerMotionWhileButtonPressed (BEvents::PointerEvent* event) override;
 
+	/**
+	 * Sliders clear their background and border and thus are never opaque.
+	 * @return FALSE
+	 */
+	virtual bool isOpaque () override;
+
 protected:
-	virtual void draw (const double x, const double y, const double width, const double height) override;
+	/**
+	 * Updates only the area between the old and the new knob position.
+	 * @param oldValue Value before the change
+	 */
+	virtual void updateDisplayedValue (const double oldValue) override;
+
+	/**
+	 * Gets the number of pixel steps along the scale.
+	 */
+	virtual int getDisplayPositions () const override;
+
+	virtual void drawStaticLayer (cairo_surface_t* surface) override;
+
+	virtual void drawDynamicLayer (cairo_t* cr, const double relVal) override;
 
 	BColors::ColorSet fgColors;
 	BColors::ColorSet bgColors;
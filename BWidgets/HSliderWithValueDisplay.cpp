@@ -78,7 +78,7 @@ Label* HSliderWithValueDisplay::getValueDisplay () {return &valueDisplay;}
 void HSliderWithValueDisplay::update ()
 {
 	updateChildCoords ();
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
@@ -19,7 +19,7 @@ Label::Label (const Label& that) : Widget (that)
 	labelFont = that.labelFont;
 	labelText = that.labelText;
 
-	draw (0, 0, width_, height_);
+	markDirty ();
 }
 
 Label::~Label () {}
@@ -59,7 +59,7 @@ BStyles::Font* Label::getFont () {return &labelFont;}
 
 void Label::update ()
 {
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
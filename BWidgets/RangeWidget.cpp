@@ -6,27 +6,37 @@
 
 namespace BWidgets
 {
+// Size limit of the filmstrip surface of a widget in bytes
+static const double FILMSTRIP_MAX_BYTES = 4.0 * 1024.0 * 1024.0;
+
 RangeWidget::RangeWidget () : RangeWidget (0.0, 0.0, 200.0, 200.0, "RangeWidget", 0.0, 0.0, 100.0, 0.0) {}
 
 RangeWidget::RangeWidget (const double  x, const double y, const double width, const double height, const std::string& name,
 						  const double value, const double min, const double max, const double step) :
 		ValueWidget (x, y, width, height, name, value), rangeMin (min <= max ? min : max),
-		rangeMax (max), rangeStep (step)
+		rangeMax (max), rangeStep (step), staticLayer (nullptr),
+		filmstrip (nullptr), filmstripFrames (0), filmstripColumns (0), filmstripValid ()
 {
 	this->value = LIMIT (value, min, max);
 }
 
 RangeWidget::RangeWidget (const RangeWidget& that) :
-	ValueWidget (that), rangeMin (that.rangeMin <= that.rangeMax ? that.rangeMin : that.rangeMax), rangeMax (that.rangeMax), rangeStep (that.rangeStep) {}
+	ValueWidget (that), rangeMin (that.rangeMin <= that.rangeMax ? that.rangeMin : that.rangeMax), rangeMax (that.rangeMax), rangeStep (that.rangeStep),
+	staticLayer (nullptr), filmstrip (nullptr), filmstripFrames (that.filmstripFrames), filmstripColumns (0), filmstripValid () {}
 
-RangeWidget::~RangeWidget () {}
+RangeWidget::~RangeWidget ()
+{
+	invalidateStaticLayer ();
+}
 
 RangeWidget& RangeWidget::operator= (const RangeWidget& that)
 {
+	invalidateStaticLayer ();
 	Widget::operator= (that);
 	rangeMin = that.rangeMin;
 	rangeMax = that.rangeMax;
 	rangeStep = that.rangeStep;
+	filmstripFrames = that.filmstripFrames;
 	setValue (that.value);
 
 	return *this;
@@ -44,6 +54,12 @@ void RangeWidget::setValue (const double val)
 	if (value != valRounded) ValueWidget::setValue (valRounded);
 }
 
+void RangeWidget::update ()
+{
+	invalidateStaticLayer ();
+	Widget::update ();
+}
+
 void RangeWidget::setMin (const double min)
 {
 	double newMin = (min <= rangeMax ? min: rangeMax);
@@ -70,9 +86,205 @@ void RangeWidget::setMax (const double max)
 
 double RangeWidget::getMax () const {return rangeMax;}
 
-void RangeWidget::setStep (const double step) {rangeStep = step;}
+void RangeWidget::setStep (const double step)
+{
+	// Reverse orientation changes the display
+	bool reverse = ((step < 0) != (rangeStep < 0));
+	rangeStep = step;
+	if (reverse) update ();
+}
 
 double RangeWidget::getStep () const {return rangeStep;}
 
+double RangeWidget::getRelativeValue (const double val) const
+{
+	double relVal;
+	if (rangeMax != rangeMin) relVal = (val - rangeMin) / (rangeMax - rangeMin);
+	else relVal = 0.5;							// min == max doesn't make any sense, but need to be handled
+	if (rangeStep < 0) relVal = 1 - relVal;		// Swap if reverse orientation
+	return relVal;
+}
+
+cairo_surface_t* RangeWidget::getStaticLayer ()
+{
+	// Invalidate on resize
+	if (staticLayer &&
+		((cairo_image_surface_get_width (staticLayer) != cairo_image_surface_get_width (widgetSurface)) ||
+		 (cairo_image_surface_get_height (staticLayer) != cairo_image_surface_get_height (widgetSurface))))
+	{
+		invalidateStaticLayer ();
+	}
+
+	if (!staticLayer)
+	{
+		staticLayer = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
+		drawStaticLayer (staticLayer);
+	}
+
+	return staticLayer;
+}
+
+void RangeWidget::invalidateStaticLayer ()
+{
+	if (staticLayer)
+	{
+		cairo_surface_destroy (staticLayer);
+		staticLayer = nullptr;
+	}
+
+	if (filmstrip)
+	{
+		cairo_surface_destroy (filmstrip);
+		filmstrip = nullptr;
+	}
+}
+
+void RangeWidget::setFilmstripFrames (const int nrFrames)
+{
+	int frames = (nrFrames >= 2 ? nrFrames : 0);
+	if (frames != filmstripFrames)
+	{
+		filmstripFrames = frames;
+		update ();
+	}
+}
+
+int RangeWidget::getFilmstripFrames () const {return filmstripFrames;}
+
+int RangeWidget::getUsedFilmstripFrames () const
+{
+	if (filmstripFrames == 0) return 0;
+
+	// Same integer size as the static layer
+	int w = int (width_);
+	int h = int (height_);
+	double frameBytes = 4.0 * (w > 1 ? w : 1) * (h > 1 ? h : 1);
+	int frames = LIMIT (int (FILMSTRIP_MAX_BYTES / frameBytes), 0, filmstripFrames);
+	return (frames >= 2 ? frames : 0);
+}
+
+double RangeWidget::getDisplayedRelativeValue (const double val) const
+{
+	double relVal = getRelativeValue (val);
+
+	int frames = getUsedFilmstripFrames ();
+	if (frames > 0)
+	{
+		double frame = round (LIMIT (relVal, 0.0, 1.0) * (frames - 1));
+		return frame / (frames - 1);
+	}
+
+	int positions = getDisplayPositions ();
+	if (positions > 0) return round (LIMIT (relVal, 0.0, 1.0) * positions) / positions;
+
+	return relVal;
+}
+
+int RangeWidget::getDisplayPositions () const {return 0;}
+
+bool RangeWidget::isDisplayChanged (const double oldValue, const double newValue) const
+{
+	return (getDisplayedRelativeValue (oldValue) != getDisplayedRelativeValue (newValue));
+}
+
+void RangeWidget::updateValue (const double oldValue)
+{
+	if (isDisplayChanged (oldValue, value)) updateDisplayedValue (oldValue);
+}
+
+void RangeWidget::updateDisplayedValue (const double oldValue) {update ();}
+
+void RangeWidget::drawStaticLayer (cairo_surface_t* surface) {drawWidgetElements (surface, 0, 0, width_, height_);}
+
+void RangeWidget::drawDynamicLayer (cairo_t* cr, const double relVal) {}
+
+void RangeWidget::draw (const double x, const double y, const double width, const double height)
+{
+	cairo_surface_t* layer = getStaticLayer ();
+	double relVal = getDisplayedRelativeValue (value);
+
+	cairo_t* cr = cairo_create (widgetSurface);
+
+	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+	{
+		// Limit cairo-drawing area
+		cairo_rectangle (cr, x, y, width, height);
+		cairo_clip (cr);
+		cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+
+		int frames = getUsedFilmstripFrames ();
+		if (frames > 0)
+		{
+			// Copy filmstrip frame
+			int frame = round (relVal * (frames - 1));
+			renderFilmstripFrame (frame);
+			int w = cairo_image_surface_get_width (layer);
+			int h = cairo_image_surface_get_height (layer);
+			cairo_set_source_surface (cr, filmstrip, -(frame % filmstripColumns) * w, -(frame / filmstripColumns) * h);
+			cairo_paint (cr);
+		}
+
+		else
+		{
+			// Copy static layer and draw the dynamic layer on top
+			cairo_set_source_surface (cr, layer, 0, 0);
+			cairo_paint (cr);
+			cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+			drawDynamicLayer (cr, relVal);
+		}
+	}
+
+	cairo_destroy (cr);
+}
+
+void RangeWidget::renderFilmstripFrame (const int frame)
+{
+	cairo_surface_t* layer = getStaticLayer ();
+	int w = cairo_image_surface_get_width (layer);
+	int h = cairo_image_surface_get_height (layer);
+
+	int frames = getUsedFilmstripFrames ();
+
+	// Rebuild if the filmstrip was built for another number of frames
+	// (filmstripValid has one entry per frame)
+	if (filmstrip && (int (filmstripValid.size ()) != frames))
+	{
+		cairo_surface_destroy (filmstrip);
+		filmstrip = nullptr;
+	}
+
+	// Frames are arranged in a grid to keep the filmstrip surface within the
+	// cairo surface size limits
+	if (!filmstrip)
+	{
+		filmstripColumns = ceil (sqrt (frames));
+		int rows = (frames + filmstripColumns - 1) / filmstripColumns;
+		filmstrip = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, filmstripColumns * w, rows * h);
+		filmstripValid.assign (frames, false);
+	}
+
+	if ((frame >= 0) && (frame < frames) && (!filmstripValid[frame]))
+	{
+		cairo_t* cr = cairo_create (filmstrip);
+
+		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+		{
+			// Frame cell in widget coordinates
+			cairo_translate (cr, (frame % filmstripColumns) * w, (frame / filmstripColumns) * h);
+			cairo_rectangle (cr, 0, 0, w, h);
+			cairo_clip (cr);
+
+			cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+			cairo_set_source_surface (cr, layer, 0, 0);
+			cairo_paint (cr);
+			cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+			drawDynamicLayer (cr, ((double) frame) / (frames - 1));
+			filmstripValid[frame] = true;
+		}
+
+		cairo_destroy (cr);
+	}
+}
+
 
 }
@@ -42,6 +42,14 @@ public:
 	 */
 	virtual void setValue (const double val) override;
 
+	/**
+	 * Invalidates the static layer, marks the widget to be redrawn and calls
+	 * postRedisplay () if the widget is visible.
+	 * This method should be called if the widgets properties are indirectly
+	 * changed.
+	 */
+	virtual void update () override;
+
 	/**
 	 * Sets the lower limit. Forces the value into the new range. Emits a value
 	 * changed event (if value changed) and (if visible) an expose event.
@@ -87,10 +95,140 @@ public:
 	 */
 	double getStep () const;
 
+	/**
+	 * Enables or disables the filmstrip cache. If enabled, the widget is
+	 * rendered for a number of equally distributed positions (frames) into a
+	 * filmstrip surface. The frames are rendered lazily on first use and
+	 * value changes become a single blit of the respective frame. The
+	 * displayed position is quantized to the frames. The filmstrip is
+	 * invalidated together with the static layer (e.g., on resize or
+	 * applyTheme).
+	 * The filmstrip surface is limited to 4 MB (frames x width x height x 4
+	 * bytes) per widget. The number of frames is reduced to fit into this
+	 * limit (e.g., 256 frames up to 64x64 pixels). The filmstrip cache is
+	 * disabled if less than two frames fit (e.g., above 1024x1024 pixels).
+	 * @param nrFrames Number of frames (e.g., 128 or 256), 0 (default)
+	 * 				   disables the filmstrip cache
+	 */
+	void setFilmstripFrames (const int nrFrames);
+
+	/**
+	 * Gets the number of filmstrip frames.
+	 * @return Requested number of frames, 0 if the filmstrip cache is
+	 * 		   disabled
+	 */
+	int getFilmstripFrames () const;
+
 protected:
+	/**
+	 * Gets the position of a value within the range for displaying.
+	 * @param val Value
+	 * @return Relative position (0 .. 1), swapped if the step is negative
+	 * 		   (reverse orientation)
+	 */
+	double getRelativeValue (const double val) const;
+
+	/**
+	 * Gets the displayed position of a value. The position is quantized to
+	 * the filmstrip frames if the filmstrip cache is enabled. Otherwise, it
+	 * is quantized to the display positions (pixels) of the widget.
+	 * @param val Value
+	 * @return Displayed relative position (0 .. 1)
+	 */
+	double getDisplayedRelativeValue (const double val) const;
+
+	/**
+	 * Gets the number of pixel steps along the path of the value indicator
+	 * (e.g., the slider scale or the dial arc). Derived widgets override
+	 * this method according to their geometry.
+	 * @return Number of pixel steps or 0 if the value display isn't
+	 * 		   quantized (default).
+	 */
+	virtual int getDisplayPositions () const;
+
+	/**
+	 * Tests whether a value change changes the on-screen representation of
+	 * the widget.
+	 * @param oldValue Value before the change
+	 * @param newValue Value after the change
+	 * @return TRUE if the displayed positions differ, otherwise FALSE.
+	 */
+	bool isDisplayChanged (const double oldValue, const double newValue) const;
+
+	/**
+	 * Calls updateDisplayedValue after a value change only if the on-screen
+	 * representation changed.
+	 * @param oldValue Value before the change
+	 */
+	virtual void updateValue (const double oldValue) override;
+
+	/**
+	 * Updates the widget after a change of the displayed value. By default,
+	 * the whole widget is updated. Derived widgets may only mark the
+	 * changed parts to be redrawn.
+	 * @param oldValue Value before the change
+	 */
+	virtual void updateDisplayedValue (const double oldValue);
+
+	/**
+	 * Gets the static layer of the widget. The static layer caches all
+	 * value-independent parts of the widget. Thus, derived widgets only need
+	 * to draw the value-dependent parts on top of the static layer on value
+	 * changes. The static layer is (re-)drawn via drawStaticLayer if it was
+	 * invalidated or if the widget size changed.
+	 * @return Pointer to the static layer surface
+	 */
+	cairo_surface_t* getStaticLayer ();
+
+	/**
+	 * Invalidates the static layer (e.g., if the widget properties changed).
+	 * The frames of the filmstrip cache are invalidated too.
+	 */
+	void invalidateStaticLayer ();
+
+	/**
+	 * Draws the value-independent parts of the widget. By default, only the
+	 * widget elements (background and border) are drawn.
+	 * @param surface Static layer surface of the widget size
+	 */
+	virtual void drawStaticLayer (cairo_surface_t* surface);
+
+	/**
+	 * Draws the value-dependent parts of the widget on top of the static
+	 * layer. By default, nothing is drawn.
+	 * @param cr Cairo context in widget coordinates
+	 * @param relVal Relative position (0 .. 1) of the value to be displayed
+	 */
+	virtual void drawDynamicLayer (cairo_t* cr, const double relVal);
+
+	/**
+	 * Draws the widget by copying the static layer and drawing the dynamic
+	 * layer on top or by copying the respective filmstrip frame.
+	 */
+	virtual void draw (const double x, const double y, const double width, const double height) override;
+
+	/**
+	 * Gets the number of filmstrip frames used for the current widget size
+	 * (the requested number of frames limited by the filmstrip size limit).
+	 * @return Number of frames, 0 if the filmstrip cache is disabled or if
+	 * 		   the widget is too large
+	 */
+	int getUsedFilmstripFrames () const;
+
+	/**
+	 * Renders a filmstrip frame if not done yet.
+	 * @param frame Frame number
+	 */
+	void renderFilmstripFrame (const int frame);
+
 	double rangeMin;
 	double rangeMax;
 	double rangeStep;
+	cairo_surface_t* staticLayer;
+	cairo_surface_t* filmstrip;
+	int filmstripFrames;
+	int filmstripColumns;
+	std::vector<bool> filmstripValid;
 
 };
 
@@ -15,7 +15,7 @@ Text::Text (const Text& that) : Widget (that)
 	textFont = that.textFont;
 	textString = that.textString;
 
-	draw (0, 0, width_, height_);
+	markDirty ();
 }
 
 Text::~Text () {}
@@ -55,7 +55,7 @@ BStyles::Font* Text::getFont () {return &textFont;}
 
 void Text::update ()
 {
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
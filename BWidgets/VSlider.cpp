@@ -6,6 +6,9 @@
 
 namespace BWidgets
 {
+// IDs of the cached patterns
+enum {SCALE_PATTERN, KNOB_FILL_PATTERN, KNOB_STROKE_PATTERN};
+
 VSlider::VSlider () : VSlider (0, 0, 12, 100, "vslider", 0.0, 0.0, 100.0, 0.0) {}
 
 VSlider::VSlider (const double  x, const double y, const double width, const double height, const std::string& name,
@@ -29,12 +32,6 @@ VSlider& VSlider::operator= (const VSlider& that)
 	return *this;
 }
 
-void VSlider::update ()
-{
-	draw (0, 0, width_, height_);
-	if (isVisible ()) postRedisplay ();
-}
-
 void VSlider::applyTheme (BStyles::Theme& theme) {applyTheme (theme, name_);}
 
 void VSlider::applyTheme (BStyles::Theme& theme, const std::string& name)
@@ -80,49 +77,62 @@ void VSlider::onButtonPressed (BEvents::PointerEvent* event)
 
 void VSlider::onPointerMotionWhileButtonPressed (BEvents::PointerEvent* event) {onButtonPressed (event);}
 
-void VSlider::draw (const double x, const double y, const double width, const double height)
+void VSlider::updateDisplayedValue (const double oldValue)
+{
+	if ((height_ >= 4) && (width_ >= 4))
+	{
+		// Same geometry as in draw
+		double w = (width_ > 24.0 ? 12.0 : 0.5 * width_);
+		double h = (height_ / width_ >= 2 ? height_ - 2 * w : height_ - (height_ / width_) * w);
+		double yOld = height_ / 2 - h / 2 + (1 - getDisplayedRelativeValue (oldValue)) * (h - 2) + 1;
+		double yNew = height_ / 2 - h / 2 + (1 - getDisplayedRelativeValue (getValue ())) * (h - 2) + 1;
+
+		// Knob (radius w - 1, line width 0.5) and scale in between
+		double y0 = (yOld < yNew ? yOld : yNew) - w - 1;
+		double y1 = (yOld > yNew ? yOld : yNew) + w + 1;
+		updateArea (0, y0, width_, y1 - y0);
+	}
+
+	else update ();
+}
+
+int VSlider::getDisplayPositions () const
+{
+	if ((height_ < 4) || (width_ < 4)) return 0;
+
+	// Travel of the value line (h - 2, see drawDynamicLayer)
+	double w = (width_ > 24.0 ? 12.0 : 0.5 * width_);
+	double h = (height_ / width_ >= 2 ? height_ - 2 * w : height_ - (height_ / width_) * w);
+	return (h > 2 ? ceil (h - 2) : 0);
+}
+
+bool VSlider::isOpaque () {return false;}
+
+void VSlider::drawStaticLayer (cairo_surface_t* surface)
 {
 	// Draw super class widget elements first
-	Widget::draw (x, y, width, height);
+	RangeWidget::drawStaticLayer (surface);
 
-	// Draw slider
+	// Draw value-independent parts of the slider (frame and scale background)
 	// only if minimum requirements satisfied
 	if ((height_ >= 4) && (width_ >= 4))
 	{
-		cairo_surface_clear (widgetSurface);
-		cairo_t* cr = cairo_create (widgetSurface);
+		cairo_surface_clear (surface);
+		cairo_t* cr = cairo_create (surface);
 
 		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 		{
-			cairo_pattern_t* pat;
-
-			// Limit cairo-drawing area
-			cairo_rectangle (cr, x, y, width, height);
-			cairo_clip (cr);
-
 			// Calculate aspect ratios first
 			double w = (width_ > 24.0 ? 12.0 : 0.5 * width_);
 			double h = (height_ / width_ >= 2 ? height_ - 2 * w : height_ - (height_ / width_) * w);
 
-			// Relative Value (0 .. 1) for calculation of value line
-			double relVal;
-			if (getMax () != getMin ()) relVal = (getValue () - getMin ()) / (getMax () - getMin ());
-			else relVal = 0.5;							// min == max doesn't make any sense, but need to be handled
-			if (getStep() < 0) relVal = 1 - relVal;		// Swap if reverse orientation
-
-			double x1 = width_ / 2 - w / 2; double y1 = height_ / 2 - h / 2;									// Top left
-			double x2 = width_ / 2 + w / 2 - 1; double y2 = height_ / 2 - h / 2 + (1 - relVal) * (h - 2) + 1; 	// Value line right
-			double x3 = x1; double y3 = y2;																		// Value line left
-			double x4 = x2; double y4 = height_ / 2 + h / 2 - 1; 												// Bottom right
+			double x1 = width_ / 2 - w / 2; double y1 = height_ / 2 - h / 2;				// Top left
+			double x4 = width_ / 2 + w / 2 - 1; double y4 = height_ / 2 + h / 2 - 1; 	// Bottom right
 
 			if (getStep () < 0) std::swap (y1, y4); // Swap top <-> bottom if reverse orientation
 
 			// Colors uses within this method
 			BColors::Color fgInact = *fgColors.getColor (BColors::INACTIVE);
-			BColors::Color fgActive = *fgColors.getColor (BColors::ACTIVE);
-			BColors::Color fgNormal = *fgColors.getColor (BColors::NORMAL);
-			BColors::Color bgNormal = *bgColors.getColor (BColors::NORMAL);
-			BColors::Color bgActive = *bgColors.getColor (BColors::ACTIVE);
 			BColors::Color bgInact = *bgColors.getColor (BColors::INACTIVE);
 			BColors::Color bgOff = *bgColors.getColor (BColors::OFF);
 
@@ -139,49 +149,93 @@ void VSlider::draw (const double x, const double y, const double width, const do
 			cairo_fill_preserve (cr);
 			cairo_set_source_rgba (cr, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), bgOff.getAlpha ());
 			cairo_stroke (cr);
+		}
+
+		cairo_destroy (cr);
+	}
+}
 
-			// Scale active
-			pat = cairo_pattern_create_linear (x3, y3, x2, y2);
+void VSlider::drawDynamicLayer (cairo_t* cr, const double relVal)
+{
+	// Draw value-dependent parts of the slider (active scale, shadow and knob)
+	// only if minimum requirements satisfied
+	if ((height_ >= 4) && (width_ >= 4))
+	{
+		cairo_pattern_t* pat;
+
+		// Calculate aspect ratios first
+		double w = (width_ > 24.0 ? 12.0 : 0.5 * width_);
+		double h = (height_ / width_ >= 2 ? height_ - 2 * w : height_ - (height_ / width_) * w);
+
+		double x1 = width_ / 2 - w / 2; double y1 = height_ / 2 - h / 2;									// Top left
+		double x2 = width_ / 2 + w / 2 - 1; double y2 = height_ / 2 - h / 2 + (1 - relVal) * (h - 2) + 1; 	// Value line right
+		double x3 = x1; double y3 = y2;																		// Value line left
+		double x4 = x2; double y4 = height_ / 2 + h / 2 - 1; 												// Bottom right
+
+		if (getStep () < 0) std::swap (y1, y4); // Swap top <-> bottom if reverse orientation
+
+		// Colors uses within this method
+		BColors::Color fgActive = *fgColors.getColor (BColors::ACTIVE);
+		BColors::Color fgNormal = *fgColors.getColor (BColors::NORMAL);
+		BColors::Color bgNormal = *bgColors.getColor (BColors::NORMAL);
+		BColors::Color bgActive = *bgColors.getColor (BColors::ACTIVE);
+		BColors::Color bgInact = *bgColors.getColor (BColors::INACTIVE);
+		BColors::Color bgOff = *bgColors.getColor (BColors::OFF);
+
+		// Scale active (gradient across the scale, independent from value)
+		pat = getCachedPattern (SCALE_PATTERN, {width_, height_}, {fgNormal, fgActive});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_linear (x3, 0, x2, 0);
 			cairo_pattern_add_color_stop_rgba (pat, 0.0, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 0.25, fgActive.getRed (), fgActive.getGreen (), fgActive.getBlue (), fgActive.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 1, fgNormal.getRed (), fgNormal.getGreen (), fgNormal.getBlue (), fgNormal.getAlpha ());
-			cairo_rectangle (cr, x3, y3, x4 - x3, y4 - y3);
-			cairo_set_source (cr, pat);
-			cairo_fill_preserve (cr);
-			cairo_stroke (cr);
-			cairo_pattern_destroy (pat);
-
-			//Shadow
-			cairo_move_to (cr, x1, (y4 > y1 ? y4 : y1));
-			cairo_line_to (cr, x1, (y1 < y4 ? y1 : y4));
-			cairo_line_to (cr, x4, (y1 < y4 ? y1 : y4));
-			cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
-			cairo_set_line_width (cr, 1.0);
-			cairo_set_source_rgba (cr, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), 0.5 * bgOff.getAlpha ());
-			cairo_stroke (cr);
-
-
-			// Knob
-			pat = cairo_pattern_create_radial ((x2 + x3) / 2 - w / 4, (y2 + y3) / 2 - w / 4, 0.1 * w,
-											   (x2 + x3) / 2, (y2 + y3) / 2, 1.5 * w);
-			cairo_arc (cr, (x2 + x3) / 2, (y2 + y3) / 2, w - 1, 0, 2 * PI);
+			setCachedPattern (SCALE_PATTERN, {width_, height_}, {fgNormal, fgActive}, pat);
+		}
+		cairo_rectangle (cr, x3, y3, x4 - x3, y4 - y3);
+		cairo_set_source (cr, pat);
+		cairo_fill_preserve (cr);
+		cairo_stroke (cr);
+
+		//Shadow
+		cairo_move_to (cr, x1, (y4 > y1 ? y4 : y1));
+		cairo_line_to (cr, x1, (y1 < y4 ? y1 : y4));
+		cairo_line_to (cr, x4, (y1 < y4 ? y1 : y4));
+		cairo_set_source_rgba (cr, 1.0, 1.0, 1.0, 1.0);
+		cairo_set_line_width (cr, 1.0);
+		cairo_set_source_rgba (cr, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), 0.5 * bgOff.getAlpha ());
+		cairo_stroke (cr);
+
+
+		// Knob (patterns relative to the knob center, moved by the pattern matrix)
+		cairo_matrix_t matrix;
+		cairo_matrix_init_translate (&matrix, -(x2 + x3) / 2, -(y2 + y3) / 2);
+
+		pat = getCachedPattern (KNOB_FILL_PATTERN, {w}, {bgActive, bgNormal});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_radial (-w / 4, -w / 4, 0.1 * w, 0, 0, 1.5 * w);
 			cairo_pattern_add_color_stop_rgba (pat, 0, bgActive.getRed (), bgActive.getGreen (), bgActive.getBlue (), bgActive.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 1, bgNormal.getRed (), bgNormal.getGreen (), bgNormal.getBlue (), bgNormal.getAlpha ());
-			cairo_set_source (cr, pat);
-			cairo_fill_preserve (cr);
-			cairo_pattern_destroy (pat);
+			setCachedPattern (KNOB_FILL_PATTERN, {w}, {bgActive, bgNormal}, pat);
+		}
+		cairo_pattern_set_matrix (pat, &matrix);
+		cairo_arc (cr, (x2 + x3) / 2, (y2 + y3) / 2, w - 1, 0, 2 * PI);
+		cairo_set_source (cr, pat);
+		cairo_fill_preserve (cr);
 
-			pat = cairo_pattern_create_radial ( (x2 + x3) / 2 - w / 4, (y2 + y3) / 2 - w / 4, 0.1 * w,
-											    (x2 + x3) / 2, (y2 + y3) / 2, 1.2 * w);
+		pat = getCachedPattern (KNOB_STROKE_PATTERN, {w}, {bgInact, bgOff});
+		if (!pat)
+		{
+			pat = cairo_pattern_create_radial (-w / 4, -w / 4, 0.1 * w, 0, 0, 1.2 * w);
 			cairo_pattern_add_color_stop_rgba (pat, 0, bgInact.getRed (), bgInact.getGreen (), bgInact.getBlue (), bgInact.getAlpha ());
 			cairo_pattern_add_color_stop_rgba (pat, 1, bgOff.getRed (), bgOff.getGreen (), bgOff.getBlue (), bgOff.getAlpha ());
-			cairo_set_line_width (cr, 0.5);
-			cairo_set_source (cr, pat);
-			cairo_stroke (cr);
-			cairo_pattern_destroy (pat);
+			setCachedPattern (KNOB_STROKE_PATTERN, {w}, {bgInact, bgOff}, pat);
 		}
-
-		cairo_destroy (cr);
+		cairo_pattern_set_matrix (pat, &matrix);
+		cairo_set_line_width (cr, 0.5);
+		cairo_set_source (cr, pat);
+		cairo_stroke (cr);
 	}
 }
 
@@ -87,7 +87,7 @@ Label* VSliderWithValueDisplay::getValueDisplay () {return &valueDisplay;}
 void VSliderWithValueDisplay::update ()
 {
 	updateChildCoords ();
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
@@ -6,6 +6,9 @@
 
 namespace BWidgets
 {
+// IDs of the cached patterns
+enum {ON_PATTERN, OFF_PATTERN};
+
 VSwitch::VSwitch () : VSwitch (0.0, 0.0, 50.0, 50.0, "togglebutton", 0.0) {}
 
 VSwitch::VSwitch (const double x, const double y, const double width, const double height, const std::string& name, const double defaultValue) :
@@ -40,22 +43,18 @@ void VSwitch::applyTheme (BStyles::Theme& theme, const std::string& name)
 	if (btPtr || bgPtr || lbPtr) update ();
 }
 
-void VSwitch::draw (const double x, const double y, const double width, const double height)
+void VSwitch::drawState (cairo_surface_t* surface, const int state)
 {
+	// Draw super class widget elements first
+	drawWidgetElements (surface, 0, 0, width_, height_);
+
 	if ((width_ >= 6) && (height_ >= 6))
 	{
-		// Draw super class widget elements first
-		Widget::draw (x, y, width, height);
-
-		cairo_t* cr = cairo_create (widgetSurface);
+		cairo_t* cr = cairo_create (surface);
 		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 		{
 			cairo_pattern_t* pat;
 
-			// Limit cairo-drawing area
-			cairo_rectangle (cr, x, y, width, height);
-			cairo_clip (cr);
-
 			BColors::Color butColorMid = *buttonColors.getColor (BColors::NORMAL);
 			BColors::Color butColorHi = *buttonColors.getColor (BColors::ACTIVE);
 			BColors::Color butColorLo = *buttonColors.getColor (BColors::INACTIVE);
@@ -82,9 +81,7 @@ void VSwitch::draw (const double x, const double y, const double width, const do
 			cairo_set_source_rgba (cr, bgColorLo.getRed (), bgColorLo.getGreen (), bgColorLo.getGreen (), bgColorLo.getAlpha ());
 			cairo_stroke (cr);
 
-			pat = cairo_pattern_create_linear (0, 1.5, 0, h);
-
-			if (value)
+			if (state)
 			{
 				cairo_move_to (cr, 1.5 + w, 1.5 + 0.45 * h);
 				cairo_line_to (cr, 1.5 + 0.95 * w, 1.5 + 0.9 * h);
@@ -93,11 +90,17 @@ void VSwitch::draw (const double x, const double y, const double width, const do
 				cairo_set_source_rgba (cr, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getGreen (), butColorLo.getAlpha ());
 				cairo_fill (cr);
 
-				cairo_pattern_add_color_stop_rgba (pat, 0.0, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 0.45, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 0.9, butColorHi.getRed (), butColorHi.getGreen (), butColorHi.getBlue (), butColorHi.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 0.95, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getBlue (), butColorLo.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 1.0, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getBlue (), butColorLo.getAlpha ());
+				pat = getCachedPattern (ON_PATTERN, {w, h}, {butColorMid, butColorHi, butColorLo});
+				if (!pat)
+				{
+					pat = cairo_pattern_create_linear (0, 1.5, 0, h);
+					cairo_pattern_add_color_stop_rgba (pat, 0.0, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 0.45, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 0.9, butColorHi.getRed (), butColorHi.getGreen (), butColorHi.getBlue (), butColorHi.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 0.95, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getBlue (), butColorLo.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 1.0, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getBlue (), butColorLo.getAlpha ());
+					setCachedPattern (ON_PATTERN, {w, h}, {butColorMid, butColorHi, butColorLo}, pat);
+				}
 
 				cairo_move_to (cr, 1.5 + 0.05 * w, 1.5);
 				cairo_line_to (cr, 1.5 + w, 1.5);
@@ -133,11 +136,17 @@ void VSwitch::draw (const double x, const double y, const double width, const do
 				cairo_set_source_rgba (cr, butColorLo.getRed (), butColorLo.getGreen (), butColorLo.getGreen (), butColorLo.getAlpha ());
 				cairo_fill (cr);
 
-				cairo_pattern_add_color_stop_rgba (pat, 0.0, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 0.05, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 0.1, butColorHi.getRed (), butColorHi.getGreen (), butColorHi.getBlue (), butColorHi.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 0.55, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
-				cairo_pattern_add_color_stop_rgba (pat, 1.0, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+				pat = getCachedPattern (OFF_PATTERN, {w, h}, {butColorMid, butColorHi, butColorLo});
+				if (!pat)
+				{
+					pat = cairo_pattern_create_linear (0, 1.5, 0, h);
+					cairo_pattern_add_color_stop_rgba (pat, 0.0, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 0.05, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 0.1, butColorHi.getRed (), butColorHi.getGreen (), butColorHi.getBlue (), butColorHi.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 0.55, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+					cairo_pattern_add_color_stop_rgba (pat, 1.0, butColorMid.getRed (), butColorMid.getGreen (), butColorMid.getBlue (), butColorMid.getAlpha ());
+					setCachedPattern (OFF_PATTERN, {w, h}, {butColorMid, butColorHi, butColorLo}, pat);
+				}
 
 				cairo_move_to (cr, 1.5 + 0.05 * w, 1.5);
 				cairo_line_to (cr, 1.5 + w, 1.5);
@@ -163,8 +172,6 @@ void VSwitch::draw (const double x, const double y, const double width, const do
 				cairo_close_path (cr);
 				cairo_stroke (cr);
 			}
-
-			cairo_pattern_destroy (pat);
 		}
 		cairo_destroy (cr);
 	}
@@ -45,7 +45,7 @@ public:
 	virtual void applyTheme (BStyles::Theme& theme, const std::string& name);
 
 protected:
-	virtual void draw (const double x, const double y, const double width, const double height) override;
+	virtual void drawState (cairo_surface_t* surface, const int state) override;
 
 	BColors::ColorSet labelColors;
 };
@@ -22,17 +22,20 @@ void ValueWidget::setValue (const double val)
 {
 	if (val != value)
 	{
+		double oldValue = value;
 		value = val;
-		update ();
+		updateValue (oldValue);
 		postValueChanged ();
 	}
 }
 
 double ValueWidget::getValue () const {return value;}
 
+void ValueWidget::updateValue (const double oldValue) {update ();}
+
 void ValueWidget::postValueChanged ()
 {
-	if (main_)
+	if (main_ && hasEventInterest (BEvents::VALUE_CHANGED_EVENT))
 	{
 		BEvents::ValueChangedEvent* event = new BEvents::ValueChangedEvent (this, value);
 		main_->addEventToQueue (event);
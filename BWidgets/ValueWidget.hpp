@@ -48,7 +48,20 @@ public:
 	double getValue () const;
 
 protected:
+	/**
+	 * Emits a BEvents::VALUE_CHANGED_EVENT if the widget consumes value
+	 * changed events (see setEventInterest).
+	 */
 	void postValueChanged ();
+
+	/**
+	 * Updates the widget after a value change. By default, the whole widget
+	 * will be updated. Derived widgets may limit the update to the area
+	 * affected by the value change.
+	 * @param oldValue Value before the change
+	 */
+	virtual void updateValue (const double oldValue);
+
 	double value;
 };
 
@@ -16,32 +16,57 @@
  */
 
 #include "Widget.hpp"
+#include <math.h>
+#include <thread>
+#include <algorithm>
 
 namespace BWidgets
 {
+// Widgets consume all event types unless they opt out
+static const uint32_t DEFAULT_EVENT_INTERESTS = (1 << BEvents::NO_EVENT) - 1;
+
+// Tolerance of the frame deadline in percent of the frame period
+static const int FRAME_TOLERANCE_PERCENT = 25;
+
+// Hit testing of containers with at least HIT_GRID_MIN_CHILDREN children via
+// a grid of up to HIT_GRID_MAX_CELLS x HIT_GRID_MAX_CELLS cells
+static const size_t HIT_GRID_MIN_CHILDREN = 16;
+static const int HIT_GRID_MAX_CELLS = 256;
 
 Widget::Widget () : Widget (0.0, 0.0, 200.0, 200.0, "Widget") {}
 
 Widget::Widget (const double x, const double y, const double width, const double height) : Widget (x, y, width, height, "Widget") {}
 
 Widget::Widget(const double x, const double y, const double width, const double height, const std::string& name) :
-		x_ (x), y_ (y), width_ (width), height_ (height), visible (true), clickable (true), dragable (false),
-		main_ (nullptr), parent_ (nullptr), children_ (), border_ (BStyles::noBorder), background_ (BStyles::blackFill), name_ (name)
+		x_ (x), y_ (y), width_ (width), height_ (height), visible (true),
+		originX_ (0.0), originY_ (0.0), originValid_ (false), effectiveVisible_ (false), visibilityValid_ (false),
+		dirty_ (true), dirtyArea_ ({0, 0, (int) ceil (width), (int) ceil (height)}), dirtyChildren_ (false),
+		clickable (true), dragable (false), eventInterests_ (DEFAULT_EVENT_INTERESTS), callbackInterests_ (0),
+		subtreeEventInterests_ (DEFAULT_EVENT_INTERESTS),
+		main_ (nullptr), parent_ (nullptr), children_ (), border_ (BStyles::noBorder), background_ (BStyles::blackFill), name_ (name),
+		hitGrid_ ({false, 1, 1, 1.0, 1.0, {}})
 {
 	cbfunction.fill (Widget::defaultCallback);
 
+	cairo_path_cache_init (&backgroundPath_);
+	cairo_path_cache_init (&borderPath_);
 	widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
-	draw (0, 0, width_, height_);
 }
 
 Widget::Widget (const Widget& that) :
 		x_ (that.x_), y_ (that.y_), width_ (that.width_), height_ (that.height_),
-		visible (that.visible), clickable (that.clickable), dragable (that.dragable),
+		visible (that.visible),
+		originX_ (0.0), originY_ (0.0), originValid_ (false), effectiveVisible_ (false), visibilityValid_ (false),
+		dirty_ (true), dirtyArea_ ({0, 0, (int) ceil (that.width_), (int) ceil (that.height_)}), dirtyChildren_ (false),
+		clickable (that.clickable), dragable (that.dragable),
+		eventInterests_ (that.eventInterests_), callbackInterests_ (that.callbackInterests_),
+		subtreeEventInterests_ (that.eventInterests_ | that.callbackInterests_),
 		main_ (nullptr), parent_ (nullptr), children_ (), border_ (that.border_), background_ (that.background_), name_ (that.name_),
-		cbfunction (that.cbfunction)
+		cbfunction (that.cbfunction), patternCache_ (), hitGrid_ ({false, 1, 1, 1.0, 1.0, {}})
 {
+	cairo_path_cache_init (&backgroundPath_);
+	cairo_path_cache_init (&borderPath_);
 	widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, that.width_, that.height_);
-	draw (0, 0, width_, height_);
 }
 
 Widget::~Widget()
@@ -52,6 +77,9 @@ Widget::~Widget()
 	//Release children
 	for (Widget* w : children_) release (w);
 
+	clearPatternCache ();
+	cairo_path_cache_destroy (&backgroundPath_);
+	cairo_path_cache_destroy (&borderPath_);
 	cairo_surface_destroy (widgetSurface);
 }
 
@@ -62,11 +90,18 @@ Widget& Widget::operator= (const Widget& that)
 	width_ = that.width_;
 	height_ = that.height_;
 	visible = that.visible;
+	invalidateOrigin ();
+	invalidateVisibility ();
+	invalidateHitGrid ();
+	if (parent_) parent_->invalidateHitGrid ();
 	clickable = that.clickable;
 	dragable = that.dragable;
 	border_ = that.border_;
 	background_ = that.background_;
 	cbfunction = that.cbfunction;
+	eventInterests_ = that.eventInterests_;
+	callbackInterests_ = that.callbackInterests_;
+	updateSubtreeEventInterests ();
 
 	if (widgetSurface) cairo_surface_destroy (widgetSurface);
 	widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, that.width_, that.height_);
@@ -77,25 +112,23 @@ Widget& Widget::operator= (const Widget& that)
 void Widget::show ()
 {
 	visible = true;
+	invalidateVisibility ();
 
 	if (isVisible ())
 	{
-		// (Re-)draw children as they may become visible too
 		std::vector<Widget*> queue = getChildrenAsQueue ();
-		for (Widget* w : queue)
-		{
-			w->main_ = main_;
-			if (w->isVisible ()) w->draw (0, 0, w->width_, w->height_);
-		}
+		for (Widget* w : queue) w->main_ = main_;
 
-		// (Re-)draw this widget and post redisplay
-		update ();
+		// Dirty widgets of this subtree weren't drawn while hidden
+		notifyDirty ();
+		postRedisplay ();
 	}
 }
 
 void Widget::hide ()
 {
 	visible = false;
+	invalidateVisibility ();
 	if ((parent_) && parent_->isVisible ()) postRedisplay ();
 }
 
@@ -103,21 +136,18 @@ void Widget::add (Widget& child)
 {
 	child.main_ = main_;
 	child.parent_ = this;
+	child.invalidateOrigin ();
+	child.invalidateVisibility ();
 	children_.push_back (&child);
+	invalidateHitGrid ();
+	updateSubtreeEventInterests ();
 
-	// (Re-)draw children of child as they may become visible too
-	if (child.isVisible ())
-	{
-		std::vector<Widget*> queue = child.getChildrenAsQueue ();
-		for (Widget* w : queue)
-		{
-			w->main_ = main_;
-			if (w->isVisible ()) w->draw (0, 0, w->width_, w->height_);
-		}
+	std::vector<Widget*> queue = child.getChildrenAsQueue ();
+	for (Widget* w : queue) w->main_ = main_;
 
-		// (Re-)draw child widget and post redisplay
-		child.update ();
-	}
+	// Notify about dirty widgets of the child subtree
+	child.notifyDirty ();
+	if (child.isVisible ()) child.postRedisplay ();
 }
 
 void Widget::release (Widget* child)
@@ -126,6 +156,8 @@ void Widget::release (Widget* child)
 	{
 		// Delete child's connection to this widget
 		child->parent_ = nullptr;
+		child->invalidateOrigin ();
+		child->invalidateVisibility ();
 
 		if (child->main_)
 		{
@@ -135,7 +167,8 @@ void Widget::release (Widget* child)
 				if (child->main_-> getInput ((BEvents::InputDevice) i) == child) child->main_-> setInput ((BEvents::InputDevice) i, nullptr);
 			}
 
-			// Remove connection to main window
+			// Remove pending exposes and connection to main window
+			child->main_->purgeExposes (child);
 			child->main_ = nullptr;
 		}
 
@@ -150,6 +183,8 @@ void Widget::release (Widget* child)
 					postRedisplay ();
 				}
 				else children_.erase (it);
+				invalidateHitGrid ();
+				updateSubtreeEventInterests ();
 				return;
 			}
 		}
@@ -162,6 +197,8 @@ void Widget::moveTo (const double x, const double y)
 {
 	if ((x_ != x) || (y_ != y))
 	{
+		if (parent_) parent_->invalidateHitGrid ();
+
 		if (isVisible ())
 		{
 			bool vis = visible;
@@ -169,6 +206,7 @@ void Widget::moveTo (const double x, const double y)
 			postRedisplay ();
 			x_ = x;
 			y_ = y;
+			invalidateOrigin ();
 			visible = vis;
 			postRedisplay ();
 		}
@@ -176,6 +214,7 @@ void Widget::moveTo (const double x, const double y)
 		{
 			x_ = x;
 			y_ = y;
+			invalidateOrigin ();
 		}
 	}
 }
@@ -186,16 +225,27 @@ double Widget::getY () const {return y_;}
 
 double Widget::getOriginX ()
 {
-	double x = 0.0;
-	for (Widget* w = this; w->parent_; w = w->parent_) x += w->x_;
-	return x;
+	if (!originValid_)
+	{
+		if (parent_)
+		{
+			originX_ = parent_->getOriginX () + x_;
+			originY_ = parent_->getOriginY () + y_;
+		}
+		else
+		{
+			originX_ = 0.0;
+			originY_ = 0.0;
+		}
+		originValid_ = true;
+	}
+	return originX_;
 }
 
 double Widget::getOriginY ()
 {
-	double y = 0.0;
-	for (Widget* w = this; w->parent_; w = w->parent_) y += w->y_;
-	return y;
+	if (!originValid_) getOriginX ();
+	return originY_;
 }
 
 void Widget::moveFrontwards ()
@@ -211,6 +261,7 @@ void Widget::moveFrontwards ()
 				Widget* w = parent_->children_[i + 1];
 				parent_->children_[i + 1] = parent_->children_[i];
 				parent_->children_[i] = w;
+				parent_->invalidateHitGrid ();
 
 				if (parent_->isVisible ()) parent_->postRedisplay ();
 				return;
@@ -232,6 +283,7 @@ void Widget::moveBackwards ()
 				Widget* w = parent_->children_[i];
 				parent_->children_[i] = parent_->children_[i - 1];
 				parent_->children_[i - 1] = w;
+				parent_->invalidateHitGrid ();
 
 				if (parent_->isVisible ()) parent_->postRedisplay ();
 				return;
@@ -244,6 +296,9 @@ void Widget::setWidth (const double width)
 {
 	if (width_ != width)
 	{
+		invalidateHitGrid ();
+		if (parent_) parent_->invalidateHitGrid ();
+
 		if (isVisible ())
 		{
 			bool vis = visible;
@@ -253,7 +308,7 @@ void Widget::setWidth (const double width)
 			visible = vis;
 			cairo_surface_destroy (widgetSurface);	// destroy old surface first
 			widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
-			draw (0, 0, width_, height_);
+			markDirty ();
 			postRedisplay ();
 		}
 		else
@@ -261,7 +316,7 @@ void Widget::setWidth (const double width)
 			width_ =  width;
 			cairo_surface_destroy (widgetSurface);	// destroy old surface first
 			widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
-			draw (0, 0, width_, height_);
+			markDirty ();
 		}
 	}
 }
@@ -272,6 +327,9 @@ void Widget::setHeight (const double height)
 {
 	if (height_ != height)
 	{
+		invalidateHitGrid ();
+		if (parent_) parent_->invalidateHitGrid ();
+
 		if (isVisible ())
 		{
 			bool vis = visible;
@@ -281,7 +339,7 @@ void Widget::setHeight (const double height)
 			visible = vis;
 			cairo_surface_destroy (widgetSurface);	// destroy old surface first
 			widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
-			draw (0, 0, width_, height_);
+			markDirty ();
 			postRedisplay ();
 		}
 		else
@@ -289,7 +347,7 @@ void Widget::setHeight (const double height)
 			height_ = height;
 			cairo_surface_destroy (widgetSurface);	// destroy old surface first
 			widgetSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
-			draw (0, 0, width_, height_);
+			markDirty ();
 		}
 	}
 }
@@ -326,16 +384,63 @@ std::string Widget::getName () const {return name_;}
 
 void Widget::setCallbackFunction (const BEvents::EventType eventType, const std::function<void (BEvents::Event*)>& callbackFunction)
 {
-	if (eventType <= BEvents::EventType::NO_EVENT) cbfunction[eventType] = callbackFunction;
+	if (eventType < BEvents::EventType::NO_EVENT)
+	{
+		cbfunction[eventType] = callbackFunction;
+
+		// Any callback other than defaultCallback consumes the events
+		typedef void (*CallbackPtr) (BEvents::Event*);
+		const CallbackPtr* ptr = callbackFunction.target<CallbackPtr> ();
+		if (callbackFunction && !(ptr && (*ptr == Widget::defaultCallback))) callbackInterests_ |= (1 << eventType);
+		else callbackInterests_ &= ~(1 << eventType);
+		updateSubtreeEventInterests ();
+	}
+}
+
+void Widget::setEventInterest (const BEvents::EventType eventType, const bool status)
+{
+	if (eventType < BEvents::EventType::NO_EVENT)
+	{
+		if (status) eventInterests_ |= (1 << eventType);
+		else eventInterests_ &= ~(1 << eventType);
+		updateSubtreeEventInterests ();
+	}
+}
+
+bool Widget::hasEventInterest (const BEvents::EventType eventType) const
+{
+	return ((eventType < BEvents::EventType::NO_EVENT) && ((eventInterests_ | callbackInterests_) & (1 << eventType)));
 }
 
 bool Widget::isVisible()
 {
-	for (Widget* w = this; w; w = w->parent_)
+	if (!visibilityValid_)
+	{
+		effectiveVisible_ = (visible && ((!parent_) || parent_->isVisible ()));
+		visibilityValid_ = true;
+	}
+	return effectiveVisible_;
+}
+
+bool Widget::isOpaque ()
+{
+	// Margin, padding and rounded corners leave transparent areas
+	if ((border_.getMargin () != 0.0) || (border_.getPadding () != 0.0) || (border_.getRadius () != 0.0)) return false;
+
+	// Semi-transparent border line
+	if ((border_.getLine ()->getWidth () != 0.0) && (border_.getLine ()->getColor ()->getAlpha () != 1.0)) return false;
+
+	// Background image ?
+	cairo_surface_t* fillSurface = background_.getCairoSurface ();
+	if (fillSurface && (cairo_surface_status (fillSurface) == CAIRO_STATUS_SUCCESS))
 	{
-		if (!w->visible) return false;
+		return ((cairo_surface_get_content (fillSurface) == CAIRO_CONTENT_COLOR) &&
+				(cairo_image_surface_get_width (fillSurface) >= width_) &&
+				(cairo_image_surface_get_height (fillSurface) >= height_));
 	}
-	return true;
+
+	// Plain background color
+	return (background_.getColor ()->getAlpha () == 1.0);
 }
 
 void Widget::setClickable (const bool status) {clickable = status;}
@@ -348,33 +453,223 @@ bool Widget::isDragable () const {return dragable;}
 
 void Widget::update ()
 {
-	draw (0, 0, width_, height_);
+	markDirty ();
 	if (isVisible ()) postRedisplay ();
 }
 
 bool Widget::isPointInWidget (const double x, const double y) const {return ((x >= 0.0) && (x <= width_) && (y >= 0.0) && (y <= height_));}
 
+bool Widget::coversArea (const double x, const double y, const double width, const double height)
+{
+	// Fast exclusion first
+	if ((!visible) || (width <= 0.0) || (height <= 0.0) ||
+		(x < 0.0) || (y < 0.0) || (x + width > width_) || (y + height > height_) ||
+		(!isOpaque ()))
+	{
+		return false;
+	}
+
+	// Only full pixels of the widget surface on the main window surface
+	double x0 = getOriginX ();
+	double y0 = getOriginY ();
+	double xmin = ceil (x0) - x0;
+	double ymin = ceil (y0) - y0;
+	double xmax = floor (x0 + (int) width_) - x0;
+	double ymax = floor (y0 + (int) height_) - y0;
+	return ((x >= xmin) && (y >= ymin) && (x + width <= xmax) && (y + height <= ymax));
+}
+
 Widget* Widget::getWidgetAt (const double x, const double y, const bool checkVisibility, const bool checkClickability, const bool checkDragability)
 {
 	if (main_ && isPointInWidget (x, y) && ((!checkVisibility) || visible))
 	{
-		Widget* finalw = ((!checkClickability) || clickable ? this : nullptr);
-		for (Widget* w : children_)
+		// Front-to-back: The first (topmost) child hit wins. Containers
+		// with many children only test the children of the grid cell at
+		// the position.
+		if (children_.size () >= HIT_GRID_MIN_CHILDREN)
 		{
-			double xNew = x - w->x_;
-			double yNew = y - w->y_;
-			Widget* nextw = w->getWidgetAt (xNew, yNew, checkVisibility, checkClickability, checkDragability);
-			if (nextw)
+			if (!hitGrid_.valid) buildHitGrid ();
+
+			int column = LIMIT (int (x / hitGrid_.cellWidth), 0, hitGrid_.columns - 1);
+			int row = LIMIT (int (y / hitGrid_.cellHeight), 0, hitGrid_.rows - 1);
+			const std::vector<uint32_t>& cell = hitGrid_.cells[row * hitGrid_.columns + column];
+
+			for (size_t i = cell.size (); i > 0; --i)
 			{
-				finalw = nextw;
+				Widget* w = children_[cell[i - 1]];
+				Widget* nextw = w->getWidgetAt (x - w->x_, y - w->y_, checkVisibility, checkClickability, checkDragability);
+				if (nextw) return nextw;
 			}
 		}
-		return finalw;
+
+		else
+		{
+			for (size_t i = children_.size (); i > 0; --i)
+			{
+				Widget* w = children_[i - 1];
+				Widget* nextw = w->getWidgetAt (x - w->x_, y - w->y_, checkVisibility, checkClickability, checkDragability);
+				if (nextw) return nextw;
+			}
+		}
+
+		return ((!checkClickability) || clickable ? this : nullptr);
 	}
 
 	else return nullptr;
 }
 
+void Widget::invalidateHitGrid () {hitGrid_.valid = false;}
+
+void Widget::buildHitGrid ()
+{
+	// Grid of about one child per cell
+	const size_t size = children_.size ();
+	const double ratio = (height_ > 0.0 ? width_ / height_ : 1.0);
+	hitGrid_.columns = LIMIT (int (ceil (sqrt (size * ratio))), 1, HIT_GRID_MAX_CELLS);
+	hitGrid_.rows = LIMIT (int (ceil (double (size) / hitGrid_.columns)), 1, HIT_GRID_MAX_CELLS);
+	hitGrid_.cellWidth = (width_ > 0.0 ? width_ / hitGrid_.columns : 1.0);
+	hitGrid_.cellHeight = (height_ > 0.0 ? height_ / hitGrid_.rows : 1.0);
+
+	// Keep the allocated cells
+	hitGrid_.cells.resize (hitGrid_.columns * hitGrid_.rows);
+	for (std::vector<uint32_t>& cell : hitGrid_.cells) cell.clear ();
+
+	// Add children in z-order to all cells overlapped by their bounds
+	for (size_t i = 0; i < size; ++i)
+	{
+		Widget* w = children_[i];
+		if ((w->x_ > width_) || (w->x_ + w->width_ < 0.0) || (w->y_ > height_) || (w->y_ + w->height_ < 0.0)) continue;
+
+		int c0 = LIMIT (int (w->x_ / hitGrid_.cellWidth), 0, hitGrid_.columns - 1);
+		int c1 = LIMIT (int ((w->x_ + w->width_) / hitGrid_.cellWidth), 0, hitGrid_.columns - 1);
+		int r0 = LIMIT (int (w->y_ / hitGrid_.cellHeight), 0, hitGrid_.rows - 1);
+		int r1 = LIMIT (int ((w->y_ + w->height_) / hitGrid_.cellHeight), 0, hitGrid_.rows - 1);
+
+		for (int r = r0; r <= r1; ++r)
+		{
+			for (int c = c0; c <= c1; ++c) hitGrid_.cells[r * hitGrid_.columns + c].push_back (i);
+		}
+	}
+
+	hitGrid_.valid = true;
+}
+
+void Widget::updateSubtreeEventInterests ()
+{
+	for (Widget* w = this; w; w = w->parent_)
+	{
+		uint32_t interests = w->eventInterests_ | w->callbackInterests_;
+		for (Widget* c : w->children_) interests |= c->subtreeEventInterests_;
+
+		if (interests == w->subtreeEventInterests_) break;
+		w->subtreeEventInterests_ = interests;
+	}
+}
+
+bool Widget::isFrontmost (const double x, const double y, const double width, const double height)
+{
+	double xp = x;
+	double yp = y;
+	Widget* w = this;
+
+	for (; w->parent_; w = w->parent_)
+	{
+		Widget* p = w->parent_;
+
+		// Area relative to parent has to be within the visible parent
+		xp += w->x_;
+		yp += w->y_;
+		if ((!p->visible) || (xp < 0.0) || (yp < 0.0) || (xp + width > p->width_) || (yp + height > p->height_)) return false;
+
+		// No visible siblings in front within the area
+		for (int i = p->children_.size () - 1; (i >= 0) && (p->children_[i] != w); --i)
+		{
+			Widget* s = p->children_[i];
+			if (s->visible && (s->x_ < xp + width) && (s->x_ + s->width_ > xp) && (s->y_ < yp + height) && (s->y_ + s->height_ > yp))
+			{
+				return false;
+			}
+		}
+	}
+
+	return (w == main_);
+}
+
+void Widget::invalidateOrigin ()
+{
+	if (originValid_)
+	{
+		originValid_ = false;
+		for (Widget* w : children_) w->invalidateOrigin ();
+	}
+}
+
+void Widget::invalidateVisibility ()
+{
+	if (visibilityValid_)
+	{
+		visibilityValid_ = false;
+		for (Widget* w : children_) w->invalidateVisibility ();
+	}
+}
+
+void Widget::updateArea (const double x, const double y, const double width, const double height)
+{
+	markDirty (x, y, width, height);
+	if (isVisible ()) postRedisplay (getOriginX () + x, getOriginY () + y, width, height);
+}
+
+void Widget::markDirty () {markDirty (0, 0, width_, height_);}
+
+void Widget::markDirty (const double x, const double y, const double width, const double height)
+{
+	// Round out to full pixels and limit to the widget
+	int x0 = floor (x > 0.0 ? x : 0.0);
+	int y0 = floor (y > 0.0 ? y : 0.0);
+	int x1 = ceil (x + width < width_ ? x + width : width_);
+	int y1 = ceil (y + height < height_ ? y + height : height_);
+	if ((x1 <= x0) || (y1 <= y0)) return;
+
+	// Merge with the already marked area
+	if (dirty_)
+	{
+		if (dirtyArea_.x < x0) x0 = dirtyArea_.x;
+		if (dirtyArea_.y < y0) y0 = dirtyArea_.y;
+		if (dirtyArea_.x + dirtyArea_.width > x1) x1 = dirtyArea_.x + dirtyArea_.width;
+		if (dirtyArea_.y + dirtyArea_.height > y1) y1 = dirtyArea_.y + dirtyArea_.height;
+	}
+
+	dirtyArea_ = {x0, y0, x1 - x0, y1 - y0};
+	dirty_ = true;
+	notifyDirty ();
+}
+
+void Widget::notifyDirty ()
+{
+	if (dirty_ || dirtyChildren_)
+	{
+		for (Widget* w = parent_; w && (!w->dirtyChildren_); w = w->parent_) w->dirtyChildren_ = true;
+	}
+}
+
+void Widget::collectDirty (std::vector<Widget*>& widgets)
+{
+	if (dirty_)
+	{
+		dirty_ = false;
+		widgets.push_back (this);
+	}
+
+	if (dirtyChildren_)
+	{
+		dirtyChildren_ = false;
+		for (Widget* w : children_)
+		{
+			if (w->visible && (w->dirty_ || w->dirtyChildren_)) w->collectDirty (widgets);
+		}
+	}
+}
+
 void Widget::applyTheme (BStyles::Theme& theme) {applyTheme (theme, name_);}
 
 void Widget::applyTheme (BStyles::Theme& theme, const std::string& name)
@@ -398,7 +693,16 @@ void Widget::onExpose (BEvents::ExposeEvent* event) {} // Empty, only Windows ha
 void Widget::onClose () {} // Empty, only Windows handle close events
 void Widget::onButtonPressed (BEvents::PointerEvent* event) {cbfunction[BEvents::EventType::BUTTON_PRESS_EVENT] (event);}
 void Widget::onButtonReleased (BEvents::PointerEvent* event) {cbfunction[BEvents::EventType::BUTTON_RELEASE_EVENT] (event);}
-void Widget::onPointerMotion (BEvents::PointerEvent* event) {cbfunction[BEvents::EventType::POINTER_MOTION_EVENT] (event);}
+void Widget::onPointerMotion (BEvents::PointerEvent* event)
+{
+	// Not overridden and no callback: Opt out of pointer motion events
+	if (!(callbackInterests_ & (1 << BEvents::EventType::POINTER_MOTION_EVENT)))
+	{
+		setEventInterest (BEvents::EventType::POINTER_MOTION_EVENT, false);
+	}
+
+	cbfunction[BEvents::EventType::POINTER_MOTION_EVENT] (event);
+}
 
 void Widget::onPointerMotionWhileButtonPressed (BEvents::PointerEvent* event)
 {
@@ -406,7 +710,16 @@ void Widget::onPointerMotionWhileButtonPressed (BEvents::PointerEvent* event)
 	cbfunction[BEvents::EventType::POINTER_MOTION_WHILE_BUTTON_PRESSED_EVENT] (event);
 }
 
-void Widget::onValueChanged (BEvents::ValueChangedEvent* event) {cbfunction[BEvents::EventType::VALUE_CHANGED_EVENT] (event);}
+void Widget::onValueChanged (BEvents::ValueChangedEvent* event)
+{
+	// Not overridden and no callback: Opt out of value changed events
+	if (!(callbackInterests_ & (1 << BEvents::EventType::VALUE_CHANGED_EVENT)))
+	{
+		setEventInterest (BEvents::EventType::VALUE_CHANGED_EVENT, false);
+	}
+
+	cbfunction[BEvents::EventType::VALUE_CHANGED_EVENT] (event);
+}
 
 void Widget::defaultCallback (BEvents::Event* event) {}
 
@@ -451,29 +764,79 @@ void Widget::redisplay (cairo_surface_t* surface, double x, double y, double wid
 {
 	if (main_ && visible && fitToArea (x, y, width, height))
 	{
+		// Look for the topmost child covering the whole area. This widget
+		// and all children below are hidden.
+		size_t first = 0;
+		bool covered = false;
+		for (size_t i = children_.size (); (i > 0) && (!covered); --i)
+		{
+			Widget* w = children_[i - 1];
+			if (w->coversArea (x - w->x_, y - w->y_, width, height))
+			{
+				first = i - 1;
+				covered = true;
+			}
+		}
+
 		// Copy widgets surface onto main surface
-		double x0 = getOriginX ();
-		double y0 = getOriginY ();
+		if (!covered)
+		{
+			double x0 = getOriginX ();
+			double y0 = getOriginY ();
 
-		cairo_t* cr = cairo_create (surface);
-		cairo_set_source_surface (cr, widgetSurface, x0, y0);
-		cairo_rectangle (cr, x + x0, y + y0, width, height);
-		cairo_fill (cr);
-		cairo_destroy (cr);
+			cairo_t* cr = cairo_create (surface);
 
-		for (Widget* w : children_)
+			// Opaque widgets replace the underlying pixels (no blending)
+			if ((x + x0 == floor (x + x0)) && (y + y0 == floor (y + y0)) &&
+				(width == floor (width)) && (height == floor (height)) && isOpaque ())
+			{
+				cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+			}
+
+			cairo_set_source_surface (cr, widgetSurface, x0, y0);
+			cairo_rectangle (cr, x + x0, y + y0, width, height);
+			cairo_fill (cr);
+			cairo_destroy (cr);
+		}
+
+		for (size_t i = first; i < children_.size (); ++i)
 		{
-			double xNew = x - w->x_;
-			double yNew = y - w->y_;
-			w->redisplay (surface, xNew, yNew, width, height);
+			Widget* w = children_[i];
+			if (!w->visible) continue;
+
+			// Part of the child within the area
+			double x1 = (x > w->x_ ? x : w->x_);
+			double y1 = (y > w->y_ ? y : w->y_);
+			double x2 = (x + width < w->x_ + w->width_ ? x + width : w->x_ + w->width_);
+			double y2 = (y + height < w->y_ + w->height_ ? y + height : w->y_ + w->height_);
+			if ((x2 <= x1) || (y2 <= y1)) continue;
+
+			// Skip children covered by opaque siblings in front
+			bool hidden = false;
+			for (size_t j = i + 1; (j < children_.size ()) && (!hidden); ++j)
+			{
+				Widget* v = children_[j];
+				hidden = v->coversArea (x1 - v->x_, y1 - v->y_, x2 - x1, y2 - y1);
+			}
+
+			if (!hidden)
+			{
+				double xNew = x - w->x_;
+				double yNew = y - w->y_;
+				w->redisplay (surface, xNew, yNew, width, height);
+			}
 		}
 	}
 }
 
 void Widget::draw (const double x, const double y, const double width, const double height)
 {
-	cairo_surface_clear (widgetSurface);
-	cairo_t* cr = cairo_create (widgetSurface);
+	drawWidgetElements (widgetSurface, x, y, width, height);
+}
+
+void Widget::drawWidgetElements (cairo_surface_t* surface, const double x, const double y, const double width, const double height)
+{
+	cairo_t* cr = cairo_create (surface);
 
 	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 	{
@@ -481,6 +844,11 @@ void Widget::draw (const double x, const double y, const double width, const dou
 		cairo_rectangle (cr, x, y, width, height);
 		cairo_clip (cr);
 
+		// Clear the drawing area only
+		cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+		cairo_paint (cr);
+		cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+
 		double radius = border_.getRadius ();
 
 		// Draw background
@@ -507,7 +875,7 @@ void Widget::draw (const double x, const double y, const double width, const dou
 				}
 				else
 				{
-					cairo_rectangle_rounded (cr, innerBorders, innerBorders, getEffectiveWidth (), getEffectiveHeight (), innerRadius);
+					cairo_rectangle_rounded_cached (cr, &backgroundPath_, innerBorders, innerBorders, getEffectiveWidth (), getEffectiveHeight (), innerRadius);
 				}
 				cairo_fill (cr);
 			}
@@ -524,8 +892,8 @@ void Widget::draw (const double x, const double y, const double width, const dou
 			(height_ >= 2 * outerBorders))
 		{
 			double lw = border_.getLine()->getWidth();
-			cairo_rectangle_rounded (cr, outerBorders + lw / 2, outerBorders + lw / 2,
-									 width_ - 2 * outerBorders - lw, height_ - 2 * outerBorders - lw, radius);
+			cairo_rectangle_rounded_cached (cr, &borderPath_, outerBorders + lw / 2, outerBorders + lw / 2,
+											width_ - 2 * outerBorders - lw, height_ - 2 * outerBorders - lw, radius);
 
 			cairo_set_source_rgba (cr, lc.getRed(), lc.getGreen(), lc.getBlue(), lc.getAlpha());
 			cairo_set_line_width (cr, lw);
@@ -536,6 +904,48 @@ void Widget::draw (const double x, const double y, const double width, const dou
 	cairo_destroy (cr);
 }
 
+cairo_pattern_t* Widget::getCachedPattern (const int id, std::initializer_list<double> geometry, std::initializer_list<BColors::Color> colors)
+{
+	for (CachedPattern& c : patternCache_)
+	{
+		if (c.id == id)
+		{
+			if
+			(
+				(c.geometry.size () == geometry.size ()) && std::equal (geometry.begin (), geometry.end (), c.geometry.begin ()) &&
+				(c.colors.size () == colors.size ()) && std::equal (colors.begin (), colors.end (), c.colors.begin ())
+			) return c.pattern;
+			return nullptr;
+		}
+	}
+	return nullptr;
+}
+
+void Widget::setCachedPattern (const int id, std::initializer_list<double> geometry, std::initializer_list<BColors::Color> colors, cairo_pattern_t* pattern)
+{
+	for (CachedPattern& c : patternCache_)
+	{
+		if (c.id == id)
+		{
+			if (c.pattern && (c.pattern != pattern)) cairo_pattern_destroy (c.pattern);
+			c.geometry.assign (geometry);
+			c.colors.assign (colors);
+			c.pattern = pattern;
+			return;
+		}
+	}
+	patternCache_.push_back ({id, geometry, colors, pattern});
+}
+
+void Widget::clearPatternCache ()
+{
+	for (CachedPattern& c : patternCache_)
+	{
+		if (c.pattern) cairo_pattern_destroy (c.pattern);
+	}
+	patternCache_.clear ();
+}
+
 bool Widget::fitToArea (double& x, double& y, double& width, double& height)
 {
 	bool isInArea = true;
@@ -605,7 +1015,13 @@ Window::Window () : Window (200.0, 200.0, "Main Window", 0.0) {}
 
 Window::Window (const double width, const double height, const std::string& title, PuglNativeWindow nativeWindow, bool resizable) :
 		Widget (0.0, 0.0, width, height, title), title_ (title), view_ (NULL), nativeWindow_ (nativeWindow), quit_ (false),
-		input ({nullptr, nullptr, nullptr, nullptr})
+		input ({nullptr, nullptr, nullptr, nullptr}), damageRegion_ (cairo_region_create ()),
+		storageSurface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height)),
+		frameRate_ (nativeWindow ? 0.0 : 60.0), nextFrame_ (std::chrono::steady_clock::now ()), lastFrame_ (nextFrame_),
+		frameStatistics_ ({0, 0, 0.0, 0.0, 0.0, 0.0, 0}), valueChangedCoalescing_ (false), queuedValueChanges_ (),
+		drawingPool_ (nullptr), dirtyWidgets_ (),
+		compositingPool_ (nullptr), tileSize_ (256), displayList_ (), tiles_ (), tileItems_ (), damageRects_ (),
+		offscreenSurface_ (nullptr), offscreenContext_ (nullptr)
 {
 	main_ = this;
 	view_ = puglInit(NULL, NULL);
@@ -626,10 +1042,38 @@ Window::Window (const double width, const double height, const std::string& titl
 	puglSetEventFunc (view_, Window::translatePuglEvent);
 }
 
+Window::Window (const double width, const double height, const std::string& title) :
+		Widget (0.0, 0.0, width, height, title), title_ (title), view_ (NULL), nativeWindow_ (0), quit_ (false),
+		input ({nullptr, nullptr, nullptr, nullptr}), damageRegion_ (cairo_region_create ()),
+		storageSurface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height)),
+		frameRate_ (0.0), nextFrame_ (std::chrono::steady_clock::now ()), lastFrame_ (nextFrame_),
+		frameStatistics_ ({0, 0, 0.0, 0.0, 0.0, 0.0, 0}), valueChangedCoalescing_ (false), queuedValueChanges_ (),
+		drawingPool_ (nullptr), dirtyWidgets_ (),
+		compositingPool_ (nullptr), tileSize_ (256), displayList_ (), tiles_ (), tileItems_ (), damageRects_ (),
+		offscreenSurface_ (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height)), offscreenContext_ (nullptr)
+{
+	main_ = this;
+	offscreenContext_ = cairo_create (offscreenSurface_);
+
+	// Initial expose (sent by the host for onscreen windows)
+	postRedisplay ();
+}
+
 Window::~Window ()
 {
+	// Release children first. Releasing posts exposes and purges them from
+	// the damaged region, which must still exist.
+	std::vector<Widget*> children = children_;
+	for (Widget* w : children) release (w);
+
 	purgeEventQueue ();
-	puglDestroy(view_);
+	cairo_region_destroy (damageRegion_);
+	cairo_surface_destroy (storageSurface);
+	if (drawingPool_) delete drawingPool_;
+	if (compositingPool_) delete compositingPool_;
+	if (offscreenContext_) cairo_destroy (offscreenContext_);
+	if (offscreenSurface_) cairo_surface_destroy (offscreenSurface_);
+	if (view_) puglDestroy(view_);
 }
 
 PuglView* Window::getPuglView () {return view_;}
@@ -637,22 +1081,97 @@ PuglView* Window::getPuglView () {return view_;}
 cairo_t* Window::getPuglContext ()
 {
 	if (view_) return (cairo_t*) puglGetContext (view_);
-	else return NULL;
+	else return offscreenContext_;
+}
+
+bool Window::isOffscreen () const {return (offscreenSurface_ != nullptr);}
+
+cairo_surface_t* Window::getOffscreenSurface ()
+{
+	if (offscreenSurface_) cairo_surface_flush (offscreenSurface_);
+	return offscreenSurface_;
 }
 
 void Window::run ()
 {
 	while (!quit_)
 	{
-		puglWaitForEvent (view_);
+		if (!view_)
+		{
+			// Offscreen: Nothing to wait for
+			if (eventQueue.empty () && !isRenderPending ()) break;
+			if (isRenderPending ()) std::this_thread::sleep_until (nextFrame_);
+		}
+
+		else if (isRenderPending ()) std::this_thread::sleep_until (nextFrame_);
+		else puglWaitForEvent (view_);
 		handleEvents ();
 	}
 }
 
+void Window::setFrameRate (const double frameRate) {frameRate_ = (frameRate > 0.0 ? frameRate : 0.0);}
+
+double Window::getFrameRate () const {return frameRate_;}
+
+FrameStatistics Window::getFrameStatistics () const {return frameStatistics_;}
+
+void Window::resetFrameStatistics () {frameStatistics_ = {0, 0, 0.0, 0.0, 0.0, 0.0, 0};}
+
+void Window::setValueChangedCoalescing (const bool status) {valueChangedCoalescing_ = status;}
+
+bool Window::isValueChangedCoalescing () const {return valueChangedCoalescing_;}
+
+void Window::setDrawingThreads (const int nrThreads)
+{
+	if (nrThreads != getDrawingThreads ())
+	{
+		if (drawingPool_) delete drawingPool_;
+		drawingPool_ = (nrThreads > 0 ? new BThreads::ThreadPool (nrThreads) : nullptr);
+	}
+}
+
+int Window::getDrawingThreads () const {return (drawingPool_ ? drawingPool_->getNrThreads () : 0);}
+
+void Window::setCompositingThreads (const int nrThreads, const int tileSize)
+{
+	if (nrThreads != getCompositingThreads ())
+	{
+		if (compositingPool_) delete compositingPool_;
+		compositingPool_ = (nrThreads > 0 ? new BThreads::ThreadPool (nrThreads) : nullptr);
+	}
+	tileSize_ = (tileSize >= 16 ? tileSize : 16);
+}
+
+int Window::getCompositingThreads () const {return (compositingPool_ ? compositingPool_->getNrThreads () : 0);}
+
+bool Window::isRenderPending () const
+{
+	return ((!cairo_region_is_empty (damageRegion_)) || (!subtreeExposes_.empty ()));
+}
+
 void Window::onConfigure (BEvents::ExposeEvent* event)
 {
 	if (width_ != event->getWidth ()) setWidth (event->getWidth ());
 	if (height_ != event->getHeight ()) setHeight (event->getHeight ());
+
+	// Reallocate back buffer if window size changed
+	if ((cairo_image_surface_get_width (storageSurface) != (int) width_) ||
+		(cairo_image_surface_get_height (storageSurface) != (int) height_))
+	{
+		cairo_surface_destroy (storageSurface);
+		storageSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
+
+		// Offscreen windows also resize their target surface
+		if (offscreenSurface_)
+		{
+			cairo_destroy (offscreenContext_);
+			cairo_surface_destroy (offscreenSurface_);
+			offscreenSurface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
+			offscreenContext_ = cairo_create (offscreenSurface_);
+		}
+
+		postRedisplay ();
+	}
 }
 
 void Window::onClose ()
@@ -664,27 +1183,392 @@ void Window::onExpose (BEvents::ExposeEvent* event)
 {
 	if (event)
 	{
+		// Round out to full pixels
+		int x0 = floor (event->getX ());
+		int y0 = floor (event->getY ());
+		int x1 = ceil (event->getX () + event->getWidth ());
+		int y1 = ceil (event->getY () + event->getHeight ());
+		cairo_rectangle_int_t area = {x0, y0, x1 - x0, y1 - y0};
+
+		// Drop empty areas and areas already included in the damaged region
+		if ((area.width <= 0) || (area.height <= 0) ||
+			(cairo_region_contains_rectangle (damageRegion_, &area) == CAIRO_REGION_OVERLAP_IN))
+		{
+			return;
+		}
+
+		// Keep areas exposed by widgets together with the widget
 		Widget* widget = (Widget*) event->getWidget ();
+		if (widget && (widget != this))
+		{
+			for (BEvents::ExposeEvent& e : subtreeExposes_)
+			{
+				if ((e.getWidget () == widget) && (e.getX () == area.x) && (e.getY () == area.y) &&
+					(e.getWidth () == area.width) && (e.getHeight () == area.height))
+				{
+					return;
+				}
+			}
+
+			subtreeExposes_.push_back (BEvents::ExposeEvent (widget, BEvents::EXPOSE_EVENT, area.x, area.y, area.width, area.height));
+		}
+
+		// Otherwise merge area into the damaged region
+		else cairo_region_union_rectangle (damageRegion_, &area);
+	}
+}
+
+void Window::redisplayDamage ()
+{
+	// Draw dirty widgets first. Each widget draws into its own surface. Thus,
+	// they can be drawn in parallel.
+	if (visible)
+	{
+		dirtyWidgets_.clear ();
+		collectDirty (dirtyWidgets_);
+
+		if (drawingPool_ && (dirtyWidgets_.size () > 1))
+		{
+			drawingPool_->run (dirtyWidgets_.size (), [this] (const int i)
+			{
+				Widget* w = dirtyWidgets_[i];
+				w->draw (w->dirtyArea_.x, w->dirtyArea_.y, w->dirtyArea_.width, w->dirtyArea_.height);
+			});
+		}
+
+		else
+		{
+			for (Widget* w : dirtyWidgets_) w->draw (w->dirtyArea_.x, w->dirtyArea_.y, w->dirtyArea_.width, w->dirtyArea_.height);
+		}
+	}
+
+	// Limit damaged region to the back buffer area
+	cairo_rectangle_int_t bufferArea =
+	{
+		0, 0,
+		cairo_image_surface_get_width (storageSurface),
+		cairo_image_surface_get_height (storageSurface)
+	};
+	cairo_region_intersect_rectangle (damageRegion_, &bufferArea);
+
+	// Check exposes emitted by widgets: Only the subtree of an opaque widget
+	// needs to be recomposited if no other widget is in front of it.
+	// Otherwise, merge them into the damaged region.
+	std::vector<BEvents::ExposeEvent>::iterator subtreeEnd = subtreeExposes_.begin ();
+	for (BEvents::ExposeEvent& e : subtreeExposes_)
+	{
+		Widget* w = (Widget*) e.getWidget ();
+		cairo_rectangle_int_t area = {(int) e.getX (), (int) e.getY (), (int) e.getWidth (), (int) e.getHeight ()};
+
+		if (cairo_region_contains_rectangle (damageRegion_, &area) == CAIRO_REGION_OVERLAP_IN) continue;
 
-		// Create a temporal storage surface and store all children surfaces on this
-		cairo_surface_t* storageSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width_, height_);
-		redisplay (storageSurface, event->getX (), event->getY (),
-				   event->getWidth (), event->getHeight ());
+		if ((w->main_ == this) && (area.x >= 0) && (area.y >= 0) &&
+			(area.x + area.width <= bufferArea.width) && (area.y + area.height <= bufferArea.height))
+		{
+			double x = area.x - w->getOriginX ();
+			double y = area.y - w->getOriginY ();
+			if (w->coversArea (x, y, area.width, area.height) && w->isFrontmost (x, y, area.width, area.height))
+			{
+				*subtreeEnd = e;
+				++subtreeEnd;
+				continue;
+			}
+		}
+
+		cairo_region_union_rectangle (damageRegion_, &area);
+		cairo_region_intersect_rectangle (damageRegion_, &bufferArea);
+	}
+	subtreeExposes_.erase (subtreeEnd, subtreeExposes_.end ());
+
+	if (!cairo_region_is_empty (damageRegion_))
+	{
+		int nrRects = cairo_region_num_rectangles (damageRegion_);
+
+		// Clear the damaged region of the back buffer
+		cairo_t* cr = cairo_create (storageSurface);
+		for (int i = 0; i < nrRects; ++i)
+		{
+			cairo_rectangle_int_t rect;
+			cairo_region_get_rectangle (damageRegion_, i, &rect);
+			cairo_rectangle (cr, rect.x, rect.y, rect.width, rect.height);
+		}
+		cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+		cairo_fill (cr);
+		cairo_destroy (cr);
+
+		// Recomposite the damaged region of all children surfaces into the
+		// back buffer. Split large damaged regions into tiles if enabled.
+		cairo_rectangle_int_t extents;
+		cairo_region_get_extents (damageRegion_, &extents);
+		if (compositingPool_ && ((extents.width > tileSize_) || (extents.height > tileSize_))) compositeTiles ();
 
-		// Copy storage surface onto pugl provided surface
-		cairo_t* cr = main_->getPuglContext ();
+		else
+		{
+			for (int i = 0; i < nrRects; ++i)
+			{
+				cairo_rectangle_int_t rect;
+				cairo_region_get_rectangle (damageRegion_, i, &rect);
+				redisplay (storageSurface, rect.x, rect.y, rect.width, rect.height);
+			}
+		}
+	}
+
+	// Recomposite the subtrees of the remaining widget exposes into the back
+	// buffer (not included in the damaged region)
+	for (BEvents::ExposeEvent& e : subtreeExposes_)
+	{
+		Widget* w = (Widget*) e.getWidget ();
+		cairo_rectangle_int_t area = {(int) e.getX (), (int) e.getY (), (int) e.getWidth (), (int) e.getHeight ()};
+
+		if (cairo_region_contains_rectangle (damageRegion_, &area) != CAIRO_REGION_OVERLAP_IN)
+		{
+			w->redisplay (storageSurface, area.x - w->getOriginX (), area.y - w->getOriginY (), area.width, area.height);
+			cairo_region_union_rectangle (damageRegion_, &area);
+		}
+	}
+	subtreeExposes_.clear ();
+
+	if (!cairo_region_is_empty (damageRegion_))
+	{
+		// Copy the damaged region of the back buffer onto pugl provided
+		// surface
+		int nrRects = cairo_region_num_rectangles (damageRegion_);
+		cairo_t* cr = getPuglContext ();
 		cairo_save (cr);
+		for (int i = 0; i < nrRects; ++i)
+		{
+			cairo_rectangle_int_t rect;
+			cairo_region_get_rectangle (damageRegion_, i, &rect);
+			cairo_rectangle (cr, rect.x, rect.y, rect.width, rect.height);
+		}
+		cairo_clip (cr);
 		cairo_set_source_surface (cr, storageSurface, 0, 0);
 		cairo_paint (cr);
 		cairo_restore (cr);
-
-		cairo_surface_destroy (storageSurface);
 	}
+
+	// Clear damaged region
+	cairo_rectangle_int_t noArea = {0, 0, 0, 0};
+	cairo_region_intersect_rectangle (damageRegion_, &noArea);
 }
 
 void Window::addEventToQueue (BEvents::Event* event)
 {
-	eventQueue.push_back (event);
+	// Don't queue expose events. Merge them into the damaged region instead.
+	if (event && (event->getEventType () == BEvents::EXPOSE_EVENT))
+	{
+		onExpose ((BEvents::ExposeEvent*) event);
+		delete event;
+	}
+
+	// Merge pointer motion events into the most recently queued event if it
+	// is a motion event of the same widget, type and button. Otherwise, the
+	// order of the events (e.g., the hovered widget) would change.
+	else if (event && ((event->getEventType () == BEvents::POINTER_MOTION_EVENT) ||
+					   (event->getEventType () == BEvents::POINTER_MOTION_WHILE_BUTTON_PRESSED_EVENT)))
+	{
+		BEvents::PointerEvent* pev = (BEvents::PointerEvent*) event;
+		BEvents::Event* queued = (eventQueue.empty () ? nullptr : eventQueue.at (eventQueue.size () - 1));
+
+		if (queued && (queued->getWidget () == event->getWidget ()) && (queued->getEventType () == event->getEventType ()) &&
+			(((BEvents::PointerEvent*) queued)->getButton () == pev->getButton ()))
+		{
+			BEvents::PointerEvent* qev = (BEvents::PointerEvent*) queued;
+			qev->setX (pev->getX ());
+			qev->setY (pev->getY ());
+			qev->setDeltaX (qev->getDeltaX () + pev->getDeltaX ());
+			qev->setDeltaY (qev->getDeltaY () + pev->getDeltaY ());
+			delete event;
+		}
+
+		else eventQueue.push (event);
+	}
+
+	// Supersede the value of a queued value changed event of the same widget
+	else if (event && valueChangedCoalescing_ && (event->getEventType () == BEvents::VALUE_CHANGED_EVENT))
+	{
+		BEvents::ValueChangedEvent* vev = (BEvents::ValueChangedEvent*) event;
+		Widget* widget = (Widget*) event->getWidget ();
+		std::unordered_map<Widget*, BEvents::ValueChangedEvent*>::iterator it = queuedValueChanges_.find (widget);
+
+		if (it != queuedValueChanges_.end ())
+		{
+			it->second->setValue (vev->getValue ());
+			++frameStatistics_.supersededValueChanges;
+			delete event;
+		}
+
+		else
+		{
+			queuedValueChanges_[widget] = vev;
+			eventQueue.push (event);
+		}
+	}
+
+	else eventQueue.push (event);
+}
+
+void Window::collectDisplayItems (Widget* widget, const double x1, const double y1, const double x2, const double y2)
+{
+	if (!widget->visible) return;
+
+	// Displayed area of the widget: Widget area limited by the area of its
+	// parents
+	double x0 = widget->getOriginX ();
+	double y0 = widget->getOriginY ();
+	double dx1 = (x1 > x0 ? x1 : x0);
+	double dy1 = (y1 > y0 ? y1 : y0);
+	double dx2 = (x2 < x0 + widget->width_ ? x2 : x0 + widget->width_);
+	double dy2 = (y2 < y0 + widget->height_ ? y2 : y0 + widget->height_);
+	if ((dx2 <= dx1) || (dy2 <= dy1)) return;
+
+	displayList_.push_back ({widget, x0, y0, dx1, dy1, dx2, dy2, widget->isOpaque ()});
+	for (Widget* w : widget->children_) collectDisplayItems (w, dx1, dy1, dx2, dy2);
+}
+
+void Window::compositeTiles ()
+{
+	cairo_rectangle_int_t extents;
+	cairo_region_get_extents (damageRegion_, &extents);
+
+	int nrRects = cairo_region_num_rectangles (damageRegion_);
+	damageRects_.resize (nrRects);
+	for (int i = 0; i < nrRects; ++i) cairo_region_get_rectangle (damageRegion_, i, &damageRects_[i]);
+
+	// Display list of all visible widgets within the damaged area in the
+	// order of compositing
+	displayList_.clear ();
+	collectDisplayItems (this, extents.x, extents.y, extents.x + extents.width, extents.y + extents.height);
+
+	// Precalculate the tiles touched by the damaged region and the list of
+	// widgets intersecting each tile
+	int bufferWidth = cairo_image_surface_get_width (storageSurface);
+	int bufferHeight = cairo_image_surface_get_height (storageSurface);
+	size_t nrTiles = 0;
+	tiles_.clear ();
+
+	for (int ty = (extents.y / tileSize_) * tileSize_; ty < extents.y + extents.height; ty += tileSize_)
+	{
+		for (int tx = (extents.x / tileSize_) * tileSize_; tx < extents.x + extents.width; tx += tileSize_)
+		{
+			cairo_rectangle_int_t tile =
+			{
+				tx, ty,
+				(tx + tileSize_ < bufferWidth ? tileSize_ : bufferWidth - tx),
+				(ty + tileSize_ < bufferHeight ? tileSize_ : bufferHeight - ty)
+			};
+
+			// Damaged area within the tile
+			int x1 = tile.x + tile.width;
+			int y1 = tile.y + tile.height;
+			int x2 = tile.x;
+			int y2 = tile.y;
+			for (cairo_rectangle_int_t& r : damageRects_)
+			{
+				if ((r.x < tile.x + tile.width) && (r.x + r.width > tile.x) && (r.y < tile.y + tile.height) && (r.y + r.height > tile.y))
+				{
+					if (r.x < x1) x1 = r.x;
+					if (r.y < y1) y1 = r.y;
+					if (r.x + r.width > x2) x2 = r.x + r.width;
+					if (r.y + r.height > y2) y2 = r.y + r.height;
+				}
+			}
+			if (x1 < tile.x) x1 = tile.x;
+			if (y1 < tile.y) y1 = tile.y;
+			if (x2 > tile.x + tile.width) x2 = tile.x + tile.width;
+			if (y2 > tile.y + tile.height) y2 = tile.y + tile.height;
+			if ((x2 <= x1) || (y2 <= y1)) continue;
+
+			// Widgets within the damaged area of the tile (topmost first).
+			// Opaque widgets covering this area hide all widgets below.
+			if (tileItems_.size () <= nrTiles) tileItems_.push_back (std::vector<size_t> ());
+			std::vector<size_t>& items = tileItems_[nrTiles];
+			items.clear ();
+			for (size_t i = displayList_.size (); i > 0; --i)
+			{
+				DisplayItem& d = displayList_[i - 1];
+				if ((d.x1 < x2) && (d.x2 > x1) && (d.y1 < y2) && (d.y2 > y1))
+				{
+					items.push_back (i - 1);
+					if (d.opaque && (ceil (d.x1) <= x1) && (ceil (d.y1) <= y1) && (floor (d.x2) >= x2) && (floor (d.y2) >= y2)) break;
+				}
+			}
+
+			tiles_.push_back (tile);
+			++nrTiles;
+		}
+	}
+
+	// Composite the tiles in parallel. The tile surfaces share the back
+	// buffer data.
+	cairo_surface_flush (storageSurface);
+	compositingPool_->run (nrTiles, [this] (const int i) {compositeTile (i);});
+	cairo_surface_mark_dirty (storageSurface);
+}
+
+void Window::compositeTile (const int tileNr)
+{
+	cairo_rectangle_int_t& tile = tiles_[tileNr];
+	std::vector<size_t>& items = tileItems_[tileNr];
+	unsigned char* data = cairo_image_surface_get_data (storageSurface);
+	int stride = cairo_image_surface_get_stride (storageSurface);
+
+	cairo_surface_t* surface = cairo_image_surface_create_for_data
+	(
+		data + tile.y * stride + 4 * tile.x, CAIRO_FORMAT_ARGB32, tile.width, tile.height, stride
+	);
+	cairo_surface_set_device_offset (surface, -tile.x, -tile.y);
+	cairo_t* cr = cairo_create (surface);
+
+	for (cairo_rectangle_int_t& r : damageRects_)
+	{
+		// Part of the damaged area within the tile
+		int x1 = (r.x > tile.x ? r.x : tile.x);
+		int y1 = (r.y > tile.y ? r.y : tile.y);
+		int x2 = (r.x + r.width < tile.x + tile.width ? r.x + r.width : tile.x + tile.width);
+		int y2 = (r.y + r.height < tile.y + tile.height ? r.y + r.height : tile.y + tile.height);
+		if ((x2 <= x1) || (y2 <= y1)) continue;
+
+		for (size_t i = items.size (); i > 0; --i)
+		{
+			DisplayItem& d = displayList_[items[i - 1]];
+			double dx1 = (x1 > d.x1 ? x1 : d.x1);
+			double dy1 = (y1 > d.y1 ? y1 : d.y1);
+			double dx2 = (x2 < d.x2 ? x2 : d.x2);
+			double dy2 = (y2 < d.y2 ? y2 : d.y2);
+			if ((dx2 <= dx1) || (dy2 <= dy1)) continue;
+
+			// Opaque widgets replace the underlying pixels (no blending)
+			if (d.opaque && (d.x0 == floor (d.x0)) && (d.y0 == floor (d.y0)) &&
+				(dx1 == floor (dx1)) && (dy1 == floor (dy1)) && (dx2 == floor (dx2)) && (dy2 == floor (dy2)))
+			{
+				cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+			}
+			else cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+
+			cairo_set_source_surface (cr, d.widget->widgetSurface, d.x0, d.y0);
+			cairo_rectangle (cr, dx1, dy1, dx2 - dx1, dy2 - dy1);
+			cairo_fill (cr);
+		}
+	}
+
+	cairo_destroy (cr);
+	cairo_surface_destroy (surface);
+}
+
+void Window::purgeExposes (Widget* widget)
+{
+	std::vector<BEvents::ExposeEvent>::iterator it = subtreeExposes_.begin ();
+	while (it != subtreeExposes_.end ())
+	{
+		if (it->getWidget () == widget)
+		{
+			cairo_rectangle_int_t area = {(int) it->getX (), (int) it->getY (), (int) it->getWidth (), (int) it->getHeight ()};
+			cairo_region_union_rectangle (damageRegion_, &area);
+			it = subtreeExposes_.erase (it);
+		}
+		else ++it;
+	}
 }
 
 void Window::setInput (const BEvents::InputDevice device, Widget* widget)
@@ -700,9 +1584,9 @@ Widget* Window::getInput (BEvents::InputDevice device) const
 
 void Window::handleEvents ()
 {
-	puglProcessEvents (view_);
+	if (view_) puglProcessEvents (view_);
 
-	while (eventQueue.size () > 0)
+	while (!eventQueue.empty ())
 	{
 		BEvents::Event* event = eventQueue.front ();
 		if (event)
@@ -751,7 +1635,12 @@ void Window::handleEvents ()
 					break;
 
 				case BEvents::VALUE_CHANGED_EVENT:
-					widget->onValueChanged((BEvents::ValueChangedEvent*) event);
+					{
+						// Further value changes of the widget need a new event
+						std::unordered_map<Widget*, BEvents::ValueChangedEvent*>::iterator it = queuedValueChanges_.find (widget);
+						if ((it != queuedValueChanges_.end ()) && (it->second == event)) queuedValueChanges_.erase (it);
+						widget->onValueChanged((BEvents::ValueChangedEvent*) event);
+					}
 					break;
 
 				default:
@@ -761,20 +1650,63 @@ void Window::handleEvents ()
 			}
 			delete event;
 		}
-		eventQueue.erase (eventQueue.begin ());
+		eventQueue.pop ();
+	}
+
+	// Redisplay all areas damaged since the last frame at once if the next
+	// frame is due
+	if (isRenderPending ())
+	{
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now ();
+		std::chrono::steady_clock::duration period = std::chrono::duration_cast<std::chrono::steady_clock::duration>
+		(
+			std::chrono::duration<double> (frameRate_ != 0.0 ? 1.0 / frameRate_ : 0.0)
+		);
+
+		// Frames are due slightly before their deadline, thus calls of a host
+		// at the same rate aren't deferred because of jitter
+		if ((frameRate_ == 0.0) || (t0 + period * FRAME_TOLERANCE_PERCENT / 100 >= nextFrame_))
+		{
+			redisplayDamage ();
+
+			std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now ();
+			double renderTime = std::chrono::duration<double, std::micro> (t1 - t0).count ();
+			++frameStatistics_.frames;
+			frameStatistics_.lastRenderTime = renderTime;
+			frameStatistics_.totalRenderTime += renderTime;
+			if (renderTime > frameStatistics_.maxRenderTime) frameStatistics_.maxRenderTime = renderTime;
+			frameStatistics_.lastFrameInterval = std::chrono::duration<double, std::micro> (t0 - lastFrame_).count ();
+			lastFrame_ = t0;
+
+			// Advance the deadline from the previous deadline to keep the frame
+			// rate. Resync if more than one period behind.
+			if (frameRate_ != 0.0)
+			{
+				nextFrame_ += period;
+				if (nextFrame_ < t0) nextFrame_ = t0 + period;
+			}
+		}
+		else ++frameStatistics_.deferredPasses;
 	}
 }
 
 void Window::translatePuglEvent (PuglView* view, const PuglEvent* event)
 {
 	Window* w = (Window*) puglGetHandle (view);
+	if (w) w->postPuglEvent (event);
+}
+
+void Window::postPuglEvent (const PuglEvent* event)
+{
+	if (!event) return;
+
 	switch (event->type) {
 	case PUGL_BUTTON_PRESS:
 		{
-			Widget* widget = w->getWidgetAt (event->button.x, event->button.y, true, true, false);
+			Widget* widget = getWidgetAt (event->button.x, event->button.y, true, true, false);
 			if (widget)
 			{
-				w->addEventToQueue (new BEvents::PointerEvent (widget,
+				addEventToQueue (new BEvents::PointerEvent (widget,
 															  BEvents::BUTTON_PRESS_EVENT,
 															  event->button.x - widget->getOriginX (),
 															  event->button.y - widget->getOriginY (),
@@ -782,17 +1714,17 @@ void Window::translatePuglEvent (PuglView* view, const PuglEvent* event)
 															  (BEvents::InputDevice) event->button.button));
 			}
 
-			w->pointerX = event->button.x;
-			w->pointerY = event->button.y;
+			pointerX = event->button.x;
+			pointerY = event->button.y;
 		}
 		break;
 
 	case PUGL_BUTTON_RELEASE:
 		{
-			Widget* widget = w->getInput ((BEvents::InputDevice) event->button.button);
+			Widget* widget = getInput ((BEvents::InputDevice) event->button.button);
 			if (widget)
 			{
-				w->addEventToQueue (new BEvents::PointerEvent (widget,
+				addEventToQueue (new BEvents::PointerEvent (widget,
 															  BEvents::BUTTON_RELEASE_EVENT,
 															  event->button.x - widget->getOriginX (),
 															  event->button.y - widget->getOriginY (),
@@ -800,8 +1732,8 @@ void Window::translatePuglEvent (PuglView* view, const PuglEvent* event)
 															  (BEvents::InputDevice) event->button.button));
 			}
 
-			w->pointerX = event->button.x;
-			w->pointerY = event->button.y;
+			pointerX = event->button.x;
+			pointerY = event->button.y;
 		}
 		break;
 
@@ -812,47 +1744,49 @@ void Window::translatePuglEvent (PuglView* view, const PuglEvent* event)
 			// Scan for pressed buttons associated with a widget
 			for (int i = BEvents::NO_BUTTON + 1; i < BEvents::NR_OF_BUTTONS; ++i)
 			{
-				if (w->getInput ((BEvents::InputDevice) i))
+				if (getInput ((BEvents::InputDevice) i))
 				{
 					device = (BEvents::InputDevice) i;
-					Widget* widget = w->getInput (device);
-					if (widget->isDragable ())
+					Widget* widget = getInput (device);
+					if (widget->isDragable () && widget->hasEventInterest (BEvents::POINTER_MOTION_WHILE_BUTTON_PRESSED_EVENT))
 					{
-						w->addEventToQueue (new BEvents::PointerEvent (widget,
+						addEventToQueue (new BEvents::PointerEvent (widget,
 																	   BEvents::POINTER_MOTION_WHILE_BUTTON_PRESSED_EVENT,
 																	   event->motion.x - widget->getOriginX (),
 																	   event->motion.y - widget->getOriginY (),
-																	   event->motion.x - w->pointerX,
-																	   event->motion.y - w->pointerY,
+																	   event->motion.x - pointerX,
+																	   event->motion.y - pointerY,
 																	   device));
 					}
 				}
 			}
 
 			// No button associated with a widget? Only POINTER_MOTION_EVENT
-			if (device == BEvents::NO_BUTTON)
+			// to the topmost widget if it consumes them. No hit test at all
+			// if no widget consumes pointer motion events.
+			if ((device == BEvents::NO_BUTTON) && (subtreeEventInterests_ & (1 << BEvents::POINTER_MOTION_EVENT)))
 			{
-				Widget* widget = w->getWidgetAt (event->motion.x, event->motion.y, true, false, false);
-				if (widget)
+				Widget* widget = getWidgetAt (event->motion.x, event->motion.y, true, false, false);
+				if (widget && widget->hasEventInterest (BEvents::POINTER_MOTION_EVENT))
 				{
-					w->addEventToQueue (new BEvents::PointerEvent (widget,
+					addEventToQueue (new BEvents::PointerEvent (widget,
 																   BEvents::POINTER_MOTION_EVENT,
 																   event->motion.x - widget->getOriginX (),
 																   event->motion.y - widget->getOriginY (),
-																   event->motion.x - w->pointerX,
-																   event->motion.y - w->pointerY,
+																   event->motion.x - pointerX,
+																   event->motion.y - pointerY,
 																   device));
 				}
 
 			}
 
-			w->pointerX = event->motion.x;
-			w->pointerY = event->motion.y;
+			pointerX = event->motion.x;
+			pointerY = event->motion.y;
 		}
 		break;
 
 	case PUGL_CONFIGURE:
-		w->addEventToQueue (new BEvents::ExposeEvent (w,
+		addEventToQueue (new BEvents::ExposeEvent (this,
 													  BEvents::CONFIGURE_EVENT,
 													  event->configure.x,
 													  event->configure.y,
@@ -861,11 +1795,11 @@ void Window::translatePuglEvent (PuglView* view, const PuglEvent* event)
 		break;
 
 	case PUGL_EXPOSE:
-		w->postRedisplay ();
+		postRedisplay ();
 		break;
 
 	case PUGL_CLOSE:
-		w->addEventToQueue (new BEvents::Event (w, BEvents::CLOSE_EVENT));
+		addEventToQueue (new BEvents::Event (this, BEvents::CLOSE_EVENT));
 		break;
 
 	default: break;
@@ -875,12 +1809,13 @@ void Window::translatePuglEvent (PuglView* view, const PuglEvent* event)
 
 void Window::purgeEventQueue ()
 {
-	while (eventQueue.size () > 0)
+	while (!eventQueue.empty ())
 	{
 		BEvents::Event* event = eventQueue.front ();
 		if (event) delete event;
-		eventQueue.erase (eventQueue.begin ());
+		eventQueue.pop ();
 	}
+	queuedValueChanges_.clear ();
 }
 
 }
@@ -23,14 +23,19 @@
 #include "pugl/pugl.h"
 #include <stdint.h>
 #include <vector>
+#include <array>
 #include <string>
 #include <iostream>
 #include <functional>
+#include <initializer_list>
+#include <chrono>
+#include <unordered_map>
 
 #include "BColors.hpp"
 #include "BStyles.hpp"
 #include "BEvents.hpp"
 #include "BValues.hpp"
+#include "BThreads.hpp"
 
 namespace BWidgets
 {
@@ -45,8 +50,26 @@ namespace BWidgets
  */
 class Window; // Forward declaration
 
+/**
+ * Struct BWidgets::FrameStatistics
+ *
+ * Frame statistics of a BWidgets::Window. Times in microseconds.
+ */
+struct FrameStatistics
+{
+	uint64_t frames;			// Rendered frames
+	uint64_t deferredPasses;	// Event handling passes with rendering deferred to the next frame tick
+	double lastRenderTime;		// Time to draw and composite the last frame
+	double maxRenderTime;
+	double totalRenderTime;
+	double lastFrameInterval;	// Time between the last two frames
+	uint64_t supersededValueChanges;	// Value changed events superseded by coalescing
+};
+
 class Widget
 {
+	friend class Window;
+
 public:
 	Widget ();
 	Widget (const double x, const double y, const double width, const double height);
@@ -142,8 +165,8 @@ public:
 	void moveFrontwards ();
 
 	/**
-	 * Resizes the widget, redraw and emits a BEvents::ExposeEvent if the
-	 * widget is visible.
+	 * Resizes the widget, marks it to be redrawn and emits a
+	 * BEvents::ExposeEvent if the widget is visible.
 	 * @param width New widgets width
 	 */
 	virtual void setWidth (const double width);
@@ -155,8 +178,8 @@ public:
 	double getWidth () const;
 
 	/**
-	 * Resizes the widget, redraw and emits a BEvents::ExposeEvent if the
-	 * widget is visible.
+	 * Resizes the widget, marks it to be redrawn and emits a
+	 * BEvents::ExposeEvent if the widget is visible.
 	 * @param height New widgets height
 	 */
 	virtual void setHeight (const double height);
@@ -168,8 +191,8 @@ public:
 	double getHeight () const;
 
 	/**
-	 * (Re-)Defines the border of the widget. Redraws widget and emits a
-	 * BEvents::ExposeEvent if the widget is visible.
+	 * (Re-)Defines the border of the widget. Marks the widget to be redrawn
+	 * and emits a BEvents::ExposeEvent if the widget is visible.
 	 * @param border New widgets border
 	 */
 	virtual void setBorder (const BStyles::Border& border);
@@ -181,8 +204,8 @@ public:
 	BStyles::Border* getBorder ();
 
 	/**
-	 * (Re-)Defines the background of the widget. Redraws widget and emits a
-	 * BEvents::ExposeEvent if the widget is visible.
+	 * (Re-)Defines the background of the widget. Marks the widget to be redrawn
+	 * and emits a BEvents::ExposeEvent if the widget is visible.
 	 * @param background New widgets background
 	 */
 	void setBackground (const BStyles::Fill& background);
@@ -240,6 +263,20 @@ public:
 	 */
 	bool isVisible ();
 
+	/**
+	 * Tests whether the widget surface is completely opaque. By default, the
+	 * opacity is inferred from the widgets background and border: Opaque
+	 * background color (or an opaque background image covering the whole
+	 * widget), an opaque or no border line, and neither margin, padding nor
+	 * rounded corners. Widgets drawing transparent areas onto their
+	 * background may override this method to declare their opacity.
+	 * Opaque widgets are used for occlusion culling and are copied onto the
+	 * main window surface without blending.
+	 * @return TRUE if all pixels of the widget surface are opaque, otherwise
+	 * 		   FALSE.
+	 */
+	virtual bool isOpaque ();
+
 	/**
 	 * Defines whether the widget may emit BEvents::BUTTON_PRESS_EVENT's
 	 * following a host button event.
@@ -270,13 +307,46 @@ public:
 	bool isDragable () const;
 
 	/**
-	 * Calls a redraw of the widget and calls postRedisplay () if the the
-	 * Widget is visible.
+	 * Declares whether the widget (i.e., its onXXX method) consumes events of
+	 * an event type. By default, widgets consume all event types. Widgets
+	 * may opt out (e.g., of BEvents::POINTER_MOTION_EVENT or
+	 * BEvents::VALUE_CHANGED_EVENT) if they don't override the respective
+	 * onXXX method. The default onPointerMotion and onValueChanged methods
+	 * opt out automatically if they are called with defaultCallback as
+	 * callback function. Events which aren't consumed are neither created nor
+	 * queued, and pointer motion isn't hit-tested if no widget of the
+	 * window consumes it. Independent of this declaration, a callback
+	 * function other than defaultCallback consumes the events until it is
+	 * reset to defaultCallback.
+	 * @param eventType Enumeration of the event type
+	 * @param status TRUE if the widget consumes the events, otherwise FALSE
+	 */
+	void setEventInterest (const BEvents::EventType eventType, const bool status);
+
+	/**
+	 * Gets whether the widget consumes events of an event type.
+	 * @param eventType Enumeration of the event type
+	 * @return TRUE if the widget consumes the events, otherwise FALSE
+	 */
+	bool hasEventInterest (const BEvents::EventType eventType) const;
+
+	/**
+	 * Marks the widget to be redrawn and calls postRedisplay () if the the
+	 * Widget is visible. The widget will be redrawn by its main window just
+	 * before compositing.
 	 * This method should be called if the widgets properties are indirectly
 	 * changed.
 	 */
 	virtual void update ();
 
+	/**
+	 * Marks an area of the widget to be redrawn and calls postRedisplay for
+	 * this area if the widget is visible. Use this method instead of update
+	 * if only a part of the widget is changed.
+	 * @param x, y, width, height Area relative to the widgets origin
+	 */
+	void updateArea (const double x, const double y, const double width, const double height);
+
 	/**
 	 * Requests a redisplay of the widgets area (and all underlying widget
 	 * areas) by emitting a BEvents::ExposeEvent.
@@ -286,7 +356,9 @@ public:
 	/**
 	 * (Re-)Defines the callback function for an event. It is on the onXXX
 	 * methods whether a callback function will be called or not. By default,
-	 * the callback is set to defaultCallback.
+	 * the callback is set to defaultCallback. Any other callback function
+	 * makes the widget consume the events of the event type (see
+	 * setEventInterest).
 	 * @param eventType Enumeration of the event type.
 	 * @param callbackFunction Function that should be called if an onXXX
 	 * 						   method is called as response of an event and
@@ -337,7 +409,10 @@ public:
 
 	/**
 	 * Predefined empty method to handle a
-	 * BEvents::EventType::POINTER_MOTION_EVENT.
+	 * BEvents::EventType::POINTER_MOTION_EVENT. Calls the callback function.
+	 * If it is defaultCallback, the widget opts out of pointer motion events
+	 * (see setEventInterest). Overriding methods should not call this method
+	 * if they still need pointer motion events.
 	 * @param event Pointer event
 	 */
 	virtual void onPointerMotion (BEvents::PointerEvent* event);
@@ -351,7 +426,10 @@ public:
 
 	/**
 	 * Predefined empty method to handle a
-	 * BEvents::EventType::VALUE_CHANGED_EVENT.
+	 * BEvents::EventType::VALUE_CHANGED_EVENT. Calls the callback function.
+	 * If it is defaultCallback, the widget opts out of value changed events
+	 * (see setEventInterest). Overriding methods should not call this method
+	 * if they still need value changed events.
 	 * @param event Value changed event
 	 */
 	virtual void onValueChanged (BEvents::ValueChangedEvent* event);
@@ -410,19 +488,136 @@ protected:
 	std::vector <Widget*> getChildrenAsQueue (std::vector <Widget*> queue = {}) const;
 
 	bool isPointInWidget (const double x, const double y) const;
+
+	/**
+	 * Tests whether the widget is visible, opaque and fully covers an area.
+	 * Only full pixels of the main window surface are considered to be
+	 * covered.
+	 * @param x, y, width, height Area relative to the widgets origin
+	 * @return TRUE if the widget covers the whole area, otherwise FALSE.
+	 */
+	bool coversArea (const double x, const double y, const double width, const double height);
+
+	/**
+	 * Tests whether no other widget is in front of this widget within an
+	 * area and whether the area is completely within the visible parent
+	 * widgets up to the main window.
+	 * @param x, y, width, height Area relative to the widgets origin
+	 * @return TRUE if the area is only displayed by this widget and its
+	 * 		   children, otherwise FALSE.
+	 */
+	bool isFrontmost (const double x, const double y, const double width, const double height);
+
+	/**
+	 * Invalidates the cached origin (and effective visibility) of this widget
+	 * and all its children. Children of widgets with invalid caches are
+	 * invalid too. Thus, subtrees already invalidated are skipped.
+	 */
+	void invalidateOrigin ();
+	void invalidateVisibility ();
+
+	/**
+	 * Marks the widget (or an area of the widget) to be redrawn before the
+	 * next compositing. Dirty areas are merged and rounded out to full
+	 * pixels. Parent widgets are notified about dirty children.
+	 * @param x, y, width, height Area relative to the widgets origin
+	 */
+	void markDirty ();
+	void markDirty (const double x, const double y, const double width, const double height);
+	void notifyDirty ();
+
+	/**
+	 * Collects this widget and its visible children if marked as dirty and
+	 * removes their marks. Hidden widgets keep their marks until they are
+	 * shown.
+	 * @param widgets Vector to which the dirty widgets are appended
+	 */
+	void collectDirty (std::vector<Widget*>& widgets);
+
+	/**
+	 * Gets the topmost widget of this subtree at a position.
+	 * @param x, y Position relative to the widgets origin
+	 * @param checkVisibility, checkClickability, checkDragability Only
+	 * 		  visible (clickable, dragable) widgets are hit
+	 * @return Pointer to the widget or nullptr if no widget was hit
+	 */
 	Widget* getWidgetAt (const double x, const double y, const bool checkVisibility, const bool checkClickability, const bool checkDragability);
 
+	/**
+	 * Marks the hit testing grid of the children as outdated. Has to be
+	 * called if children are added, released, moved, resized or change
+	 * their z-order, or if the widget is resized.
+	 */
+	void invalidateHitGrid ();
+
+	/**
+	 * (Re-)Builds the hit testing grid of the children.
+	 */
+	void buildHitGrid ();
+
+	/**
+	 * Recalculates the event interests of the subtree (this widget and all
+	 * its children) and passes changes up to the parent widgets.
+	 */
+	void updateSubtreeEventInterests ();
+
 	void postRedisplay (const double x, const double y, const double width, const double height);
 	void redisplay (cairo_surface_t* surface, double x, double y, double width, double height);
 
 	virtual void draw (const double x, const double y, const double width, const double height);
 
+	/**
+	 * Draws the widget elements (background and border) into a surface of
+	 * the widget size.
+	 * @param surface Target surface
+	 * @param x, y, width, height Area to be drawn (cleared before)
+	 */
+	void drawWidgetElements (cairo_surface_t* surface, const double x, const double y, const double width, const double height);
+
+	/**
+	 * Gets a pattern from the widget pattern cache. Cached patterns are
+	 * identified by an ID and keyed by the geometry and the colors used to
+	 * build them. Cached patterns are owned by the widget and must not be
+	 * destroyed.
+	 * @param id Pattern ID
+	 * @param geometry Geometry parameters used to build the pattern
+	 * @param colors Colors used to build the pattern
+	 * @return Pointer to the cached pattern or nullptr if there is no pattern
+	 * 		   with this ID or the key changed.
+	 */
+	cairo_pattern_t* getCachedPattern (const int id, std::initializer_list<double> geometry, std::initializer_list<BColors::Color> colors);
+
+	/**
+	 * Stores a pattern in the widget pattern cache and takes its ownership.
+	 * A pattern previously cached with the same ID is destroyed.
+	 * @param id Pattern ID
+	 * @param geometry Geometry parameters used to build the pattern
+	 * @param colors Colors used to build the pattern
+	 * @param pattern Pattern to be cached
+	 */
+	void setCachedPattern (const int id, std::initializer_list<double> geometry, std::initializer_list<BColors::Color> colors, cairo_pattern_t* pattern);
+
+	/**
+	 * Destroys all cached patterns.
+	 */
+	void clearPatternCache ();
+
 	bool fitToArea (double& x, double& y, double& width, double& height);
 
 	double x_, y_, width_, height_;
 	bool visible;
+	double originX_, originY_;
+	bool originValid_;
+	bool effectiveVisible_;
+	bool visibilityValid_;
+	bool dirty_;
+	cairo_rectangle_int_t dirtyArea_;
+	bool dirtyChildren_;
 	bool clickable;
 	bool dragable;
+	uint32_t eventInterests_;
+	uint32_t callbackInterests_;
+	uint32_t subtreeEventInterests_;
 	Window* main_;
 	Widget* parent_;
 	std::vector <Widget*> children_;
@@ -431,6 +626,36 @@ protected:
 	std::string name_;
 	std::array<std::function<void (BEvents::Event*)>, BEvents::EventType::NO_EVENT> cbfunction;
 	cairo_surface_t* widgetSurface;
+	cairo_path_cache backgroundPath_;
+	cairo_path_cache borderPath_;
+
+private:
+	struct CachedPattern
+	{
+		int id;
+		std::vector<double> geometry;
+		std::vector<BColors::Color> colors;
+		cairo_pattern_t* pattern;
+	};
+
+	std::vector<CachedPattern> patternCache_;
+
+	/**
+	 * Grid of the children bounds for hit testing of containers with many
+	 * children. Each cell contains the indices of the children (in z-order)
+	 * overlapping the cell.
+	 */
+	struct HitGrid
+	{
+		bool valid;
+		int columns;
+		int rows;
+		double cellWidth;
+		double cellHeight;
+		std::vector<std::vector<uint32_t>> cells;
+	};
+
+	HitGrid hitGrid_;
 };
 
 /**
@@ -442,6 +667,9 @@ protected:
  * via Pugl, receives host events via Pugl and coordinates handling of all
  * events. Configure, expose, and close events will be handled directly and
  * exclusively by this widget.
+ * Alternatively, a BWidgets::Window can be created offscreen (headless)
+ * without any connection to a display server. Then it renders into an image
+ * surface and receives synthetic Pugl events only.
  */
 class Window : public Widget
 {
@@ -449,6 +677,15 @@ public:
 	Window ();
 	Window (const double width, const double height, const std::string& title, PuglNativeWindow nativeWindow, bool resizable = false);
 
+	/**
+	 * Creates an offscreen (headless) window. Events have to be passed via
+	 * postPuglEvent and the rendered frames can be read back from
+	 * getOffscreenSurface. The maximum frame rate is unlimited by default.
+	 * @param width, height Window size
+	 * @param title Window title
+	 */
+	Window (const double width, const double height, const std::string& title);
+
 	Window (const Window& that) = delete;	// Only one window in this version
 
 	~Window ();
@@ -467,35 +704,155 @@ public:
 	 */
 	cairo_t* getPuglContext ();
 
+	/**
+	 * Tests whether the window is an offscreen (headless) window.
+	 * @return TRUE if offscreen, otherwise FALSE.
+	 */
+	bool isOffscreen () const;
+
+	/**
+	 * Gets the surface of an offscreen window. The surface contains the
+	 * last rendered frame (the same content a Pugl view would show).
+	 * @return Pointer to the image surface or nullptr if the window isn't an
+	 * 		   offscreen window.
+	 */
+	cairo_surface_t* getOffscreenSurface ();
+
 	/**
 	 * Runs the window until the close flag is set and thus it will be closed.
-	 * For stand-alone applications.
+	 * For stand-alone applications. Waits for the next frame tick if
+	 * rendering is pending, otherwise waits for events.
+	 * Offscreen windows only run until all queued events are handled and all
+	 * pending rendering is done.
 	 */
 	void run ();
 
+	/**
+	 * Translates a Pugl event into BEvents::Event derived objects and queues
+	 * them. Used for events from the host via Pugl and for synthetic events
+	 * (e.g., for offscreen windows).
+	 * @param event Pugl event in window coordinates
+	 */
+	void postPuglEvent (const PuglEvent* event);
+
+	/**
+	 * Sets the maximum frame rate. All damaged areas and dirty widgets
+	 * between two frame ticks are rendered at once. Frame ticks follow a
+	 * fixed period. A frame is also rendered if handleEvents is called
+	 * slightly (up to a quarter period) before the next tick.
+	 * @param frameRate Maximum frame rate in Hz (default 60 for stand-alone
+	 * 					windows), 0 for unlimited (render on each
+	 * 					handleEvents call, default for windows embedded
+	 * 					into a host via nativeWindow and offscreen windows).
+	 */
+	void setFrameRate (const double frameRate);
+
+	/**
+	 * Gets the maximum frame rate.
+	 * @return Maximum frame rate in Hz, 0 for unlimited
+	 */
+	double getFrameRate () const;
+
+	/**
+	 * Gets the frame statistics since the window creation or the last call
+	 * of resetFrameStatistics.
+	 * @return Frame statistics
+	 */
+	FrameStatistics getFrameStatistics () const;
+
+	void resetFrameStatistics ();
+
+	/**
+	 * Enables or disables the coalescing of BEvents::VALUE_CHANGED_EVENTs.
+	 * If enabled, a value changed event of a widget which still has got a
+	 * queued value changed event only updates the value of the queued
+	 * event. Thus, only the latest value of each widget is delivered per
+	 * handleEvents call. The number of superseded events is counted in the
+	 * frame statistics.
+	 * @param status TRUE to enable, FALSE (default) to disable coalescing
+	 */
+	void setValueChangedCoalescing (const bool status);
+
+	/**
+	 * Gets the status of the coalescing of BEvents::VALUE_CHANGED_EVENTs.
+	 * @return TRUE if enabled, otherwise FALSE
+	 */
+	bool isValueChangedCoalescing () const;
+
+	/**
+	 * Enables or disables the parallel drawing of dirty widgets. If enabled,
+	 * the widgets marked as dirty are drawn on a pool of worker threads
+	 * (and the calling thread) before compositing. Compositing is still
+	 * done single-threaded.
+	 * Drawing methods of widgets must not change other widgets or shared
+	 * data if enabled.
+	 * @param nrThreads Number of worker threads, 0 (default) disables
+	 * 					parallel drawing
+	 */
+	void setDrawingThreads (const int nrThreads);
+
+	/**
+	 * Gets the number of worker threads used for parallel drawing.
+	 * @return Number of worker threads, 0 if disabled
+	 */
+	int getDrawingThreads () const;
+
+	/**
+	 * Enables or disables tile-based parallel compositing. If enabled, large
+	 * damaged regions are split into tiles of the back buffer. The tiles
+	 * are composited independently on a pool of worker threads (and the
+	 * calling thread) using a per-tile list of intersecting widgets.
+	 * @param nrThreads Number of worker threads, 0 (default) disables
+	 * 					tile-based compositing
+	 * @param tileSize Width and height of the tiles in pixels
+	 */
+	void setCompositingThreads (const int nrThreads, const int tileSize = 256);
+
+	/**
+	 * Gets the number of worker threads used for tile-based compositing.
+	 * @return Number of worker threads, 0 if disabled
+	 */
+	int getCompositingThreads () const;
+
 	/**
 	 * Queues an event until the next call of the handleEvents method.
+	 * BEvents::EXPOSE_EVENTs are not queued. Their areas are merged into the
+	 * damaged region of the window and the events are deleted.
+	 * A pointer motion event is merged into the most recently queued event
+	 * if it is a motion event of the same widget (and button). The merged
+	 * event gets the final position and the summed up distances.
+	 * BEvents::VALUE_CHANGED_EVENTs of a widget with a queued value changed
+	 * event update the queued event if value changed coalescing is enabled.
 	 * @param event Event
 	 */
 	void addEventToQueue (BEvents::Event* event);
 
 	/**
 	 * Main Event handler. Walks through the event queue and sorts the events
-	 * to their respective onXXX handling methods
+	 * to their respective onXXX handling methods. Finally, redisplays the
+	 * damaged region of the window at once if the next frame is due.
 	 */
 	void handleEvents ();
 
 	/**
-	 * Executes an reexposure of the area given by the expose event.
+	 * Adds the area given by the expose event to the damaged region of the
+	 * window. Areas already contained in the damaged region are dropped.
+	 * Areas exposed by other widgets than the window are kept together with
+	 * the emitting widget. If this widget is opaque and no other widget is in
+	 * front of it, only its subtree will be recomposited.
+	 * The damaged region will be reexposed at the end of the next
+	 * handleEvents call.
 	 * @param event Expose event containing the widget that emitted the event
 	 * 				and the area that should be reexposed.
 	 */
 	virtual void onExpose (BEvents::ExposeEvent* event) override;
 
 	/**
-	 * Predefined empty method to handle a BEvents::EventType::CONFIGURE_EVENT.
+	 * Resizes the window to the size given by the configure event and
+	 * reallocates the back buffer if the size changed.
 	 * BEvents::EventType::CONFIGURE_EVENTs will only be handled by
 	 * BWidget::Window.
+	 * @param event Configure event
 	 */
 	virtual void onConfigure (BEvents::ExposeEvent* event) override;
 
@@ -504,6 +861,13 @@ public:
 	 */
 	virtual void onClose () override;
 
+	/**
+	 * Removes a widget from the pending expose events (e.g., if the widget
+	 * is released). The exposed areas remain in the damaged region.
+	 * @param widget Pointer to the widget
+	 */
+	void purgeExposes (Widget* widget);
+
 	/*
 	 * Links or unlinks a mouse button to a widget.
 	 * @param device Button
@@ -528,6 +892,47 @@ protected:
 
 	void purgeEventQueue ();
 
+	/**
+	 * Executes a reexposure of the damaged region of the window and clears
+	 * the damaged region. Only the damaged region is recomposited into the
+	 * back buffer and copied onto the pugl surface.
+	 */
+	void redisplayDamage ();
+
+	/**
+	 * Tests whether there are damaged areas to be rendered.
+	 * @return TRUE if rendering is pending, otherwise FALSE.
+	 */
+	bool isRenderPending () const;
+
+	/**
+	 * Entry of the display list for tile-based compositing: A visible widget
+	 * with its origin and its displayed area (in window coordinates, limited
+	 * by the areas of its parents).
+	 */
+	struct DisplayItem
+	{
+		Widget* widget;
+		double x0, y0;
+		double x1, y1, x2, y2;
+		bool opaque;
+	};
+
+	/**
+	 * Appends a widget and all its visible children within an area to the
+	 * display list.
+	 * @param widget Pointer to the widget
+	 * @param x1, y1, x2, y2 Area in window coordinates
+	 */
+	void collectDisplayItems (Widget* widget, const double x1, const double y1, const double x2, const double y2);
+
+	/**
+	 * Recomposites the damaged region of the back buffer tile by tile on the
+	 * compositing thread pool.
+	 */
+	void compositeTiles ();
+	void compositeTile (const int tileNr);
+
 	std::string title_;
 	PuglView* view_;
 	PuglNativeWindow nativeWindow_;
@@ -542,7 +947,55 @@ protected:
 	 * the linked widget is released or destroyed.
 	 */
 	std::array<Widget*, BEvents::InputDevice::NR_OF_BUTTONS> input;
-	std::vector<BEvents::Event*> eventQueue;
+	BEvents::EventQueue eventQueue;
+
+	/**
+	 * Region (in window coordinates) that has to be reexposed. Collects the
+	 * areas of all expose events until they are redisplayed.
+	 */
+	cairo_region_t* damageRegion_;
+
+	/**
+	 * Pending expose events emitted by widgets (with full pixel areas).
+	 * Candidates for the recomposition of the widgets subtree only.
+	 */
+	std::vector<BEvents::ExposeEvent> subtreeExposes_;
+
+	/**
+	 * Persistent back buffer of the window size. All widget surfaces are
+	 * composited into this surface before it is copied onto the pugl
+	 * surface. Only reallocated if the window size changes.
+	 */
+	cairo_surface_t* storageSurface;
+
+	double frameRate_;
+	std::chrono::steady_clock::time_point nextFrame_;
+	std::chrono::steady_clock::time_point lastFrame_;
+	FrameStatistics frameStatistics_;
+
+	/**
+	 * Queued (and not yet handled) BEvents::VALUE_CHANGED_EVENTs of the
+	 * widgets if value changed coalescing is enabled.
+	 */
+	bool valueChangedCoalescing_;
+	std::unordered_map<Widget*, BEvents::ValueChangedEvent*> queuedValueChanges_;
+
+	BThreads::ThreadPool* drawingPool_;
+	std::vector<Widget*> dirtyWidgets_;
+
+	BThreads::ThreadPool* compositingPool_;
+	int tileSize_;
+	std::vector<DisplayItem> displayList_;
+	std::vector<cairo_rectangle_int_t> tiles_;
+	std::vector<std::vector<size_t>> tileItems_;
+	std::vector<cairo_rectangle_int_t> damageRects_;
+
+	/**
+	 * Target surface and context of offscreen windows instead of the pugl
+	 * provided surface and context.
+	 */
+	cairo_surface_t* offscreenSurface_;
+	cairo_t* offscreenContext_;
 };
 
 }
@@ -20,6 +20,58 @@ void cairo_rectangle_rounded (cairo_t* cr, double x, double y, double width, dou
 	}
 }
 
+void cairo_path_cache_init (cairo_path_cache* cache)
+{
+	cache->key_size = 0;
+	cache->path = NULL;
+}
+
+int cairo_path_cache_append (cairo_t* cr, cairo_path_cache* cache, const double* key, int key_size)
+{
+	if (cache->path && (key_size == cache->key_size) && (memcmp (key, cache->key, key_size * sizeof (double)) == 0))
+	{
+		cairo_append_path (cr, cache->path);
+		return 1;
+	}
+
+	return 0;
+}
+
+void cairo_path_cache_store (cairo_t* cr, cairo_path_cache* cache, const double* key, int key_size)
+{
+	cairo_path_cache_destroy (cache);
+	if ((key_size < 0) || (key_size > CAIRO_PATH_CACHE_MAX_KEY)) return;
+
+	cache->path = cairo_copy_path (cr);
+	if (cache->path->status != CAIRO_STATUS_SUCCESS)
+	{
+		cairo_path_destroy (cache->path);
+		cache->path = NULL;
+		return;
+	}
+
+	memcpy (cache->key, key, key_size * sizeof (double));
+	cache->key_size = key_size;
+}
+
+void cairo_path_cache_destroy (cairo_path_cache* cache)
+{
+	if (cache->path) cairo_path_destroy (cache->path);
+	cache->path = NULL;
+	cache->key_size = 0;
+}
+
+void cairo_rectangle_rounded_cached (cairo_t* cr, cairo_path_cache* cache, double x, double y, double width, double height, double radius)
+{
+	double key[5] = {x, y, width, height, radius};
+
+	if (!cairo_path_cache_append (cr, cache, key, 5))
+	{
+		cairo_rectangle_rounded (cr, x, y, width, height, radius);
+		cairo_path_cache_store (cr, cache, key, 5);
+	}
+}
+
 cairo_surface_t* cairo_image_surface_clone_from_image_surface (cairo_surface_t* sourceSurface)
 {
 	cairo_surface_t* targetSurface = NULL;
@@ -39,6 +91,86 @@ cairo_surface_t* cairo_image_surface_clone_from_image_surface (cairo_surface_t*
 	return targetSurface;
 }
 
+int cairo_image_surface_compare (cairo_surface_t* surface1, cairo_surface_t* surface2, int tolerance, cairo_surface_t* diff)
+{
+	if (!surface1 || !surface2 ||
+		(cairo_surface_status (surface1) != CAIRO_STATUS_SUCCESS) ||
+		(cairo_surface_status (surface2) != CAIRO_STATUS_SUCCESS)) return -1;
+
+	cairo_format_t format1 = cairo_image_surface_get_format (surface1);
+	cairo_format_t format2 = cairo_image_surface_get_format (surface2);
+	int width = cairo_image_surface_get_width (surface1);
+	int height = cairo_image_surface_get_height (surface1);
+
+	if (((format1 != CAIRO_FORMAT_ARGB32) && (format1 != CAIRO_FORMAT_RGB24)) ||
+		((format2 != CAIRO_FORMAT_ARGB32) && (format2 != CAIRO_FORMAT_RGB24)) ||
+		(cairo_image_surface_get_width (surface2) != width) ||
+		(cairo_image_surface_get_height (surface2) != height)) return -1;
+
+	if (diff &&
+		((cairo_surface_status (diff) != CAIRO_STATUS_SUCCESS) ||
+		 (cairo_image_surface_get_format (diff) != CAIRO_FORMAT_ARGB32) ||
+		 (cairo_image_surface_get_width (diff) != width) ||
+		 (cairo_image_surface_get_height (diff) != height))) diff = NULL;
+
+	cairo_surface_flush (surface1);
+	cairo_surface_flush (surface2);
+	if (diff) cairo_surface_flush (diff);
+
+	unsigned char* data1 = cairo_image_surface_get_data (surface1);
+	unsigned char* data2 = cairo_image_surface_get_data (surface2);
+	unsigned char* dataDiff = (diff ? cairo_image_surface_get_data (diff) : NULL);
+	int stride1 = cairo_image_surface_get_stride (surface1);
+	int stride2 = cairo_image_surface_get_stride (surface2);
+	int strideDiff = (diff ? cairo_image_surface_get_stride (diff) : 0);
+	// Alpha is ignored if one of the surfaces has no alpha channel (e.g.,
+	// opaque images loaded from PNG)
+	uint32_t mask = ((format1 == CAIRO_FORMAT_RGB24) || (format2 == CAIRO_FORMAT_RGB24) ? 0x00FFFFFF : 0xFFFFFFFF);
+	int count = 0;
+
+	for (int y = 0; y < height; ++y)
+	{
+		uint32_t* row1 = (uint32_t*) (data1 + y * stride1);
+		uint32_t* row2 = (uint32_t*) (data2 + y * stride2);
+		uint32_t* rowDiff = (dataDiff ? (uint32_t*) (dataDiff + y * strideDiff) : NULL);
+
+		for (int x = 0; x < width; ++x)
+		{
+			uint32_t p1 = row1[x] & mask;
+			uint32_t p2 = row2[x] & mask;
+			int differs = 0;
+
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				int c1 = (p1 >> shift) & 0xFF;
+				int c2 = (p2 >> shift) & 0xFF;
+				if (abs (c1 - c2) > tolerance)
+				{
+					differs = 1;
+					break;
+				}
+			}
+
+			if (differs) ++count;
+
+			if (rowDiff)
+			{
+				if (differs) rowDiff[x] = 0xFFFF0000;
+				else
+				{
+					// Dimmed grey of the (premultiplied) surface1 pixel
+					uint32_t grey = (((p1 >> 16) & 0xFF) + ((p1 >> 8) & 0xFF) + (p1 & 0xFF)) / 12;
+					rowDiff[x] = 0xFF000000 | (grey << 16) | (grey << 8) | grey;
+				}
+			}
+		}
+	}
+
+	if (diff) cairo_surface_mark_dirty (diff);
+
+	return count;
+}
+
 void cairo_surface_clear (cairo_surface_t* surface)
 {
 	cairo_t* cr = cairo_create (surface);
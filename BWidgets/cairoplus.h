@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <cairo/cairo.h>
 
 typedef struct {
@@ -20,6 +21,14 @@ typedef struct {
 	cairo_font_weight_t weight;
 } cairo_text_decorations;
 
+#define CAIRO_PATH_CACHE_MAX_KEY 8
+
+typedef struct {
+	double key[CAIRO_PATH_CACHE_MAX_KEY];
+	int key_size;
+	cairo_path_t* path;
+} cairo_path_cache;
+
 /**
  * Draws a rectangle with rounded edges.
  * @param cr	 Cairo context.
@@ -31,6 +40,54 @@ typedef struct {
  */
 void cairo_rectangle_rounded (cairo_t* cr, double x, double y, double width, double height, double radius);
 
+/**
+ * Initializes an empty path cache.
+ * @param cache Path cache
+ */
+void cairo_path_cache_init (cairo_path_cache* cache);
+
+/**
+ * Appends the cached path to the current path of a Cairo context if the path
+ * was cached with the same key.
+ * @param cr	   Cairo context.
+ * @param cache	   Path cache
+ * @param key	   Parameters used to build the path
+ * @param key_size Number of parameters (max. CAIRO_PATH_CACHE_MAX_KEY)
+ * @return		   1 if the cached path was appended, otherwise 0.
+ */
+int cairo_path_cache_append (cairo_t* cr, cairo_path_cache* cache, const double* key, int key_size);
+
+/**
+ * Copies the current path of a Cairo context into a path cache. Thus, the
+ * current path should only contain the path to be cached. A previously
+ * cached path is destroyed.
+ * @param cr	   Cairo context.
+ * @param cache	   Path cache
+ * @param key	   Parameters used to build the path
+ * @param key_size Number of parameters (max. CAIRO_PATH_CACHE_MAX_KEY)
+ */
+void cairo_path_cache_store (cairo_t* cr, cairo_path_cache* cache, const double* key, int key_size);
+
+/**
+ * Destroys the cached path and leaves an empty path cache.
+ * @param cache Path cache
+ */
+void cairo_path_cache_destroy (cairo_path_cache* cache);
+
+/**
+ * Draws a rectangle with rounded edges like cairo_rectangle_rounded, but
+ * takes the path from a path cache if the parameters didn't change. The
+ * current path must be empty.
+ * @param cr	 Cairo context.
+ * @param cache	 Path cache
+ * @param x		 X coordinate upper right
+ * @param y		 Y coordinate upper right
+ * @param width  Rectangle width
+ * @param height Rectangle height
+ * @param radius Radius of edges
+ */
+void cairo_rectangle_rounded_cached (cairo_t* cr, cairo_path_cache* cache, double x, double y, double width, double height, double radius);
+
 /**
  * Creates a new Cairo image surface and copies the content from a source Cairo
  * image surface.
@@ -39,6 +96,21 @@ void cairo_rectangle_rounded (cairo_t* cr, double x, double y, double width, dou
  */
 cairo_surface_t* cairo_image_surface_clone_from_image_surface (cairo_surface_t* sourceSurface);
 
+/**
+ * Compares two Cairo image surfaces (ARGB32 or RGB24) pixel by pixel.
+ * @param surface1	Cairo image surface.
+ * @param surface2	Cairo image surface (ARGB32 or RGB24) of the same size.
+ * 					Alpha is ignored if one of the surfaces is RGB24.
+ * @param tolerance	Maximum difference per channel (0..255) for pixels to be
+ * 					considered as equal.
+ * @param diff		Optional ARGB32 image surface of the same size (or NULL).
+ * 					Differing pixels are painted red, equal pixels are
+ * 					painted as dimmed copy of surface1.
+ * @return			Number of differing pixels or -1 if the surfaces can't be
+ * 					compared.
+ */
+int cairo_image_surface_compare (cairo_surface_t* surface1, cairo_surface_t* surface2, int tolerance, cairo_surface_t* diff);
+
 /**
  * Clears a Cairo surface.
  * @param surface Cairo surface.
@@ -615,6 +615,10 @@ puglProcessEvents(PuglView* view)
 	   series of window resizes in the same loop from being laggy. */
 	PuglEvent expose_event = { PUGL_NOTHING };
 	PuglEvent config_event = { PUGL_NOTHING };
+
+	/* Compress consecutive motion events into the latest one.  It is
+	   dispatched before the next other event to keep the event order. */
+	PuglEvent motion_event = { PUGL_NOTHING };
 	XEvent    xevent;
 	while (XPending(view->impl->display) > 0) {
 		XNextEvent(view->impl->display, &xevent);
@@ -646,12 +650,23 @@ puglProcessEvents(PuglView* view)
 		} else if (event.type == PUGL_CONFIGURE) {
 			// Expand configure event to be dispatched after loop
 			config_event = event;
-		} else {
-			// Dispatch event to application immediately
+		} else if (event.type == PUGL_MOTION_NOTIFY) {
+			// Replace pending motion event by the latest one
+			motion_event = event;
+		} else if (event.type) {
+			// Dispatch pending motion and event to application immediately
+			if (motion_event.type) {
+				puglDispatchEvent(view, (const PuglEvent*)&motion_event);
+				motion_event.type = PUGL_NOTHING;
+			}
 			puglDispatchEvent(view, &event);
 		}
 	}
 
+	if (motion_event.type) {
+		puglDispatchEvent(view, (const PuglEvent*)&motion_event);
+	}
+
 	if (config_event.type) {
 #ifdef PUGL_HAVE_CAIRO
 		if (view->ctx_type == PUGL_CAIRO) {